@@ -0,0 +1,309 @@
+#include<iostream>
+#include<vector>
+#include<string>
+#include<algorithm>
+#include<numeric>
+#include<queue>
+#include<climits>
+#include<cstdint>
+#include<chrono>
+#include<random>
+using namespace std;
+
+// Compressed adjacency for graphs that do not fit in memory as plain CSR
+//
+// An unordered_map<Place*, int> per place spends a heap node of about
+// 32 bytes plus a bucket pointer on every edge, and plain CSR still spends
+// 8 bytes (4-byte target, 4-byte weight). Here every vertex's edges are
+// sorted by target and written to one byte stream, per edge:
+//   varint target gap, varint weight
+// The first gap is the zigzag-encoded difference to the source vertex id,
+// later gaps are the difference to the previous target. After a locality
+// reordering (graph_reordering.cpp) neighbours have nearby ids, so most gaps
+// and road weights fit in one or two bytes. Vertex v's stream starts at
+// blockStart[v / 64] + vertexStart[v]: a 64-bit base every 64 vertices and
+// a 32-bit offset per vertex; the stream ends where the next vertex's begins.
+//
+// Edges are decoded on the fly by an EdgeCursor, so Dijkstra runs on the
+// compressed form directly; the same search is written once as a template
+// over both graph types.
+
+// A single directed, weighted edge between two vertex ids
+struct Edge{
+  int from;
+  int to;
+  int weight;
+};
+
+// Plain CSR graph (as in map_navigation.cpp), the uncompressed baseline
+class CsrGraph{
+  public:
+    vector<int> offsets;
+    vector<int> targets;
+    vector<int> weights;
+
+    CsrGraph(int vertexCount, const vector<Edge>& edges) : offsets(vertexCount + 1, 0){
+      for(const Edge& edge : edges){
+        offsets[edge.from + 1]++;
+      }
+      for(int v = 0; v < vertexCount; v++){
+        offsets[v + 1] += offsets[v];
+      }
+      targets.resize(edges.size());
+      weights.resize(edges.size());
+      vector<int> next(offsets.begin(), offsets.end() - 1);
+      for(const Edge& edge : edges){
+        int slot = next[edge.from]++;
+        targets[slot] = edge.to;
+        weights[slot] = edge.weight;
+      }
+    }
+
+    int vertexCount() const{
+      return (int)offsets.size() - 1;
+    }
+
+    size_t memoryBytes() const{
+      return (offsets.size() + targets.size() + weights.size()) * sizeof(int);
+    }
+
+    // Walks the edges of one vertex: while(edge.next()) use edge.target, edge.weight
+    struct EdgeCursor{
+      const CsrGraph* graph;
+      int position;
+      int end;
+      int target;
+      int weight;
+
+      bool next(){
+        if(position == end){
+          return false;
+        }
+        target = graph->targets[position];
+        weight = graph->weights[position];
+        position++;
+        return true;
+      }
+    };
+
+    EdgeCursor edges(int vertex) const{
+      return EdgeCursor{this, offsets[vertex], offsets[vertex + 1], 0, 0};
+    }
+};
+
+// Appends value as a little-endian base-128 varint
+static void writeVarint(vector<uint8_t>& out, uint32_t value){
+  while(value >= 0x80){
+    out.push_back((uint8_t)(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back((uint8_t)value);
+}
+
+// Reads a varint written by writeVarint and advances p past it
+static inline uint32_t readVarint(const uint8_t*& p){
+  uint32_t value = *p++;
+  if(value < 0x80){
+    return value;  // One-byte fast path: most gaps and weights
+  }
+  value &= 0x7f;
+  for(int shift = 7; ; shift += 7){
+    uint32_t byte = *p++;
+    value |= (byte & 0x7f) << shift;
+    if(byte < 0x80){
+      return value;
+    }
+  }
+}
+
+static uint32_t zigzag(int value){
+  return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static int unzigzag(uint32_t value){
+  return (int)(value >> 1) ^ -(int)(value & 1);
+}
+
+// Immutable delta + varint encoded graph; weights must be non-negative
+class CompressedGraph{
+  public:
+    CompressedGraph(int vertexCount, const vector<Edge>& edges)
+      : blockStart((vertexCount + 63) / 64), vertexStart(vertexCount){
+      // Group edges by source, then sort each group by target
+      CsrGraph csr(vertexCount, edges);
+      vector<pair<int, int> > group;
+      for(int v = 0; v < vertexCount; v++){
+        if(v % 64 == 0){
+          blockStart[v / 64] = bytes.size();
+        }
+        vertexStart[v] = (uint32_t)(bytes.size() - blockStart[v / 64]);
+
+        group.clear();
+        for(int e = csr.offsets[v]; e < csr.offsets[v + 1]; e++){
+          group.push_back(make_pair(csr.targets[e], csr.weights[e]));
+        }
+        sort(group.begin(), group.end());
+        int previous = v;
+        for(size_t i = 0; i < group.size(); i++){
+          writeVarint(bytes, i == 0 ? zigzag(group[i].first - v) : (uint32_t)(group[i].first - previous));
+          writeVarint(bytes, (uint32_t)group[i].second);
+          previous = group[i].first;
+        }
+      }
+      bytes.shrink_to_fit();
+    }
+
+    int vertexCount() const{
+      return (int)vertexStart.size();
+    }
+
+    size_t memoryBytes() const{
+      return bytes.size() + blockStart.size() * sizeof(uint64_t) + vertexStart.size() * sizeof(uint32_t);
+    }
+
+    // Decodes the edges of one vertex in target order
+    struct EdgeCursor{
+      const uint8_t* p;
+      const uint8_t* end;
+      bool first;
+      int target;
+      int weight;
+
+      bool next(){
+        if(p == end){
+          return false;
+        }
+        uint32_t gap = readVarint(p);
+        // target starts as the source id, so the first gap is signed
+        target += first ? unzigzag(gap) : (int)gap;
+        first = false;
+        weight = (int)readVarint(p);
+        return true;
+      }
+    };
+
+    EdgeCursor edges(int vertex) const{
+      return EdgeCursor{bytes.data() + start(vertex), bytes.data() + start(vertex + 1), true, vertex, 0};
+    }
+
+  private:
+    vector<uint8_t> bytes;
+    vector<uint64_t> blockStart;   // Byte offset of every 64th vertex
+    vector<uint32_t> vertexStart;  // Offset of each vertex within its block
+
+    // Byte offset of vertex's stream; vertex == V gives the end of the last one
+    uint64_t start(int vertex) const{
+      return vertex == vertexCount() ? bytes.size() : blockStart[vertex / 64] + vertexStart[vertex];
+    }
+};
+
+// One-to-all Dijkstra over any graph with an edges(vertex) cursor
+template<typename Graph>
+vector<int> dijkstra(const Graph& graph, int source){
+  vector<int> distances(graph.vertexCount(), INT_MAX);
+  typedef pair<int, int> HeapEntry;
+  priority_queue<HeapEntry, vector<HeapEntry>, greater<HeapEntry> > frontier;
+  distances[source] = 0;
+  frontier.push(HeapEntry(0, source));
+  while(!frontier.empty()){
+    HeapEntry top = frontier.top();
+    frontier.pop();
+    if(top.first > distances[top.second]){
+      continue;
+    }
+    for(typename Graph::EdgeCursor edge = graph.edges(top.second); edge.next(); ){
+      int newDistance = top.first + edge.weight;
+      if(newDistance < distances[edge.target]){
+        distances[edge.target] = newDistance;
+        frontier.push(HeapEntry(newDistance, edge.target));
+      }
+    }
+  }
+  return distances;
+}
+
+// Road-like side x side grid with random weights in [1, 100] in both
+// directions; with shuffle the vertex ids are a random permutation
+vector<Edge> buildGridEdges(int side, bool shuffle, unsigned seed){
+  mt19937 rng(seed);
+  uniform_int_distribution<int> weight(1, 100);
+  vector<int> id(side * side);
+  iota(id.begin(), id.end(), 0);
+  if(shuffle){
+    std::shuffle(id.begin(), id.end(), rng);
+  }
+  vector<Edge> edges;
+  for(int row = 0; row < side; row++){
+    for(int col = 0; col < side; col++){
+      int here = id[row * side + col];
+      if(col + 1 < side){
+        int w = weight(rng);
+        edges.push_back({here, id[row * side + col + 1], w});
+        edges.push_back({id[row * side + col + 1], here, w});
+      }
+      if(row + 1 < side){
+        int w = weight(rng);
+        edges.push_back({here, id[(row + 1) * side + col], w});
+        edges.push_back({id[(row + 1) * side + col], here, w});
+      }
+    }
+  }
+  return edges;
+}
+
+// Memory and one-to-all Dijkstra time of CSR against the compressed form
+void compare(const string& label, int vertexCount, const vector<Edge>& edges){
+  CsrGraph csr(vertexCount, edges);
+  auto t0 = chrono::steady_clock::now();
+  CompressedGraph compressed(vertexCount, edges);
+  double buildSeconds = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+
+  auto t1 = chrono::steady_clock::now();
+  vector<int> expected = dijkstra(csr, 0);
+  double csrSeconds = chrono::duration<double>(chrono::steady_clock::now() - t1).count();
+  auto t2 = chrono::steady_clock::now();
+  vector<int> distances = dijkstra(compressed, 0);
+  double compressedSeconds = chrono::duration<double>(chrono::steady_clock::now() - t2).count();
+
+  double edgeCount = (double)edges.size();
+  // unordered_map<Place*, int> per vertex: a node (next pointer, key, value,
+  // padding) plus malloc's header, and about one bucket pointer per edge
+  double mapBytesPerEdge = 8 + 8 + 8 + 8 + 8;
+  cout << label << ": " << vertexCount << " vertices, " << edges.size() << " edges" << endl;
+  cout << "  unordered_map: ~" << mapBytesPerEdge << " bytes/edge" << endl;
+  cout << "  CSR:           " << csr.memoryBytes() / edgeCount << " bytes/edge, Dijkstra "
+       << csrSeconds * 1000 << " ms" << endl;
+  cout << "  compressed:    " << compressed.memoryBytes() / edgeCount << " bytes/edge ("
+       << (double)csr.memoryBytes() / compressed.memoryBytes() << "x smaller than CSR, "
+       << mapBytesPerEdge * edgeCount / compressed.memoryBytes() << "x than unordered_map), Dijkstra "
+       << compressedSeconds * 1000 << " ms, build " << buildSeconds * 1000 << " ms"
+       << (distances == expected ? "" : " (MISMATCH)") << endl;
+}
+
+// Usage: ./compressed_adjacency bench [side]
+int main(int argc, char* argv[]){
+
+  if(argc > 1 && string(argv[1]) == "bench"){
+    int side = argc > 2 ? stoi(argv[2]) : 1000;
+    compare("Road grid, row-major ids", side * side, buildGridEdges(side, false, 42));
+    compare("Road grid, shuffled ids", side * side, buildGridEdges(side, true, 42));
+    return 0;
+  }
+
+  // Graph structure (ids: A=0, B=1, C=2, D=3):
+  //   A --10--> B --15--> D
+  //    \                 /
+  //     5----> C --20---
+  vector<string> names = {"A", "B", "C", "D"};
+  CompressedGraph graph(4, {{0, 1, 10}, {0, 2, 5}, {1, 3, 15}, {2, 3, 20}});
+  for(int v = 0; v < graph.vertexCount(); v++){
+    cout << names[v] << ":";
+    for(CompressedGraph::EdgeCursor edge = graph.edges(v); edge.next(); ){
+      cout << " -> " << names[edge.target] << " (" << edge.weight << ")";
+    }
+    cout << endl;
+  }
+  vector<int> distances = dijkstra(graph, 0);
+  cout << "Shortest distance A to D: " << distances[3] << endl;
+  return 0;
+}
@@ -0,0 +1,295 @@
+#include<iostream>
+#include<vector>
+#include<string>
+#include<algorithm>
+#include<thread>
+#include<atomic>
+#include<chrono>
+#include<random>
+using namespace std;
+
+// Connected components for O(1) rejection of impossible routes
+//
+// A query between two islands only learns there is no path after the
+// search has exhausted the source's whole island. Labelling every vertex
+// with a component id once, after loading, turns that into one comparison.
+//
+// Components are weak (edge directions ignored): different ids prove that
+// no route exists, equal ids mean a route may exist and the search still
+// decides (a one-way street can still make a target unreachable).
+//
+// ConcurrentUnionFind lets many threads unite edges at once without locks:
+// roots are linked with compare-and-swap, always the larger id under the
+// smaller (union by index instead of by rank, which keeps a single CAS per
+// link), and finds shorten paths by halving. The sequential UnionFind with
+// union by rank and path compression is the baseline.
+
+// A single directed, weighted edge between two vertex ids
+struct Edge{
+  int from;
+  int to;
+  int weight;
+};
+
+// Sequential union-find with union by rank and path compression
+class UnionFind{
+  public:
+    explicit UnionFind(int vertexCount) : parent(vertexCount), rank(vertexCount, 0){
+      for(int v = 0; v < vertexCount; v++){
+        parent[v] = v;
+      }
+    }
+
+    int find(int vertex){
+      int root = vertex;
+      while(parent[root] != root){
+        root = parent[root];
+      }
+      while(parent[vertex] != root){
+        int next = parent[vertex];
+        parent[vertex] = root;
+        vertex = next;
+      }
+      return root;
+    }
+
+    // Returns false if a and b were already in the same set
+    bool unite(int a, int b){
+      a = find(a);
+      b = find(b);
+      if(a == b){
+        return false;
+      }
+      if(rank[a] < rank[b]){
+        swap(a, b);
+      }
+      parent[b] = a;
+      rank[a] += rank[a] == rank[b];
+      return true;
+    }
+
+  private:
+    vector<int> parent;
+    vector<unsigned char> rank;
+};
+
+// Lock-free union-find; find and unite may run on any number of threads
+class ConcurrentUnionFind{
+  public:
+    explicit ConcurrentUnionFind(int vertexCount) : parent(vertexCount){
+      for(int v = 0; v < vertexCount; v++){
+        parent[v].store(v, memory_order_relaxed);
+      }
+    }
+
+    // Path halving: every visited vertex is pointed at its grandparent
+    int find(int vertex){
+      for(;;){
+        int up = parent[vertex].load(memory_order_relaxed);
+        if(up == vertex){
+          return vertex;
+        }
+        int grand = parent[up].load(memory_order_relaxed);
+        if(grand != up){
+          parent[vertex].compare_exchange_weak(up, grand, memory_order_relaxed);
+        }
+        vertex = grand;
+      }
+    }
+
+    // Links the larger root under the smaller one; retries if another
+    // thread moved either root in the meantime
+    void unite(int a, int b){
+      for(;;){
+        a = find(a);
+        b = find(b);
+        if(a == b){
+          return;
+        }
+        if(a < b){
+          swap(a, b);
+        }
+        int expected = a;
+        if(parent[a].compare_exchange_strong(expected, b, memory_order_relaxed)){
+          return;
+        }
+      }
+    }
+
+  private:
+    vector<atomic<int> > parent;
+};
+
+// Component id of every vertex, numbered 0 .. count - 1 by smallest member
+class ComponentIndex{
+  public:
+    vector<int> component;
+    vector<int> sizes;
+
+    // Unites all edges with threadCount threads, then labels every vertex
+    ComponentIndex(int vertexCount, const vector<Edge>& edges, int threadCount) : component(vertexCount){
+      threadCount = max(1, threadCount);
+      ConcurrentUnionFind sets(vertexCount);
+      runParallel(threadCount, edges.size(), [&](size_t i){
+        sets.unite(edges[i].from, edges[i].to);
+      });
+      // Roots are the smallest vertex of their set, so a root's label is
+      // settled before any larger member needs it
+      runParallel(threadCount, vertexCount, [&](size_t v){
+        component[v] = sets.find((int)v);
+      });
+      for(int v = 0; v < vertexCount; v++){
+        if(component[v] == v){
+          component[v] = (int)sizes.size();
+          sizes.push_back(0);
+        }
+        else{
+          component[v] = component[component[v]];
+        }
+        sizes[component[v]]++;
+      }
+    }
+
+    int count() const{
+      return (int)sizes.size();
+    }
+
+    // False proves there is no route from a to b
+    bool mayBeConnected(int a, int b) const{
+      return component[a] == component[b];
+    }
+
+  private:
+    // Calls body(i) for i in [0, count), handed out in chunks to the threads
+    template<typename Body>
+    static void runParallel(int threadCount, size_t count, const Body& body){
+      const size_t chunk = 4096;
+      atomic<size_t> next(0);
+      auto worker = [&](){
+        for(size_t begin = next.fetch_add(chunk); begin < count; begin = next.fetch_add(chunk)){
+          size_t end = min(count, begin + chunk);
+          for(size_t i = begin; i < end; i++){
+            body(i);
+          }
+        }
+      };
+      vector<thread> threads;
+      for(int t = 1; t < threadCount; t++){
+        threads.push_back(thread(worker));
+      }
+      worker();
+      for(thread& t : threads){
+        t.join();
+      }
+    }
+};
+
+// Sequential labelling with the rank-based union-find, for comparison
+vector<int> sequentialComponents(int vertexCount, const vector<Edge>& edges){
+  UnionFind sets(vertexCount);
+  for(const Edge& edge : edges){
+    sets.unite(edge.from, edge.to);
+  }
+  vector<int> label(vertexCount, -1), component(vertexCount);
+  int count = 0;
+  for(int v = 0; v < vertexCount; v++){
+    int root = sets.find(v);
+    if(label[root] == -1){
+      label[root] = count++;
+    }
+    component[v] = label[root];
+  }
+  return component;
+}
+
+// Road-like side x side grid with random weights in [1, 100]; each road is
+// kept only with the given probability, so the grid breaks into islands
+vector<Edge> buildSparseGridEdges(int side, double keep, unsigned seed){
+  mt19937 rng(seed);
+  uniform_int_distribution<int> weight(1, 100);
+  bernoulli_distribution kept(keep);
+  vector<Edge> edges;
+  for(int row = 0; row < side; row++){
+    for(int col = 0; col < side; col++){
+      int here = row * side + col;
+      if(col + 1 < side && kept(rng)){
+        int w = weight(rng);
+        edges.push_back({here, here + 1, w});
+        edges.push_back({here + 1, here, w});
+      }
+      if(row + 1 < side && kept(rng)){
+        int w = weight(rng);
+        edges.push_back({here, here + side, w});
+        edges.push_back({here + side, here, w});
+      }
+    }
+  }
+  return edges;
+}
+
+// Uniform random directed graph with weights in [1, 100]
+vector<Edge> buildRandomEdges(int vertexCount, int edgeCount, unsigned seed){
+  mt19937 rng(seed);
+  uniform_int_distribution<int> vertex(0, vertexCount - 1);
+  uniform_int_distribution<int> weight(1, 100);
+  vector<Edge> edges(edgeCount);
+  for(Edge& edge : edges){
+    edge = {vertex(rng), vertex(rng), weight(rng)};
+  }
+  return edges;
+}
+
+// Times the sequential labelling and the parallel one for 1, 2, 4, ...
+// threads up to the core count, checking every labelling
+void speedupCurve(const string& label, int vertexCount, const vector<Edge>& edges){
+  auto t0 = chrono::steady_clock::now();
+  vector<int> expected = sequentialComponents(vertexCount, edges);
+  double sequentialSeconds = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+
+  int cores = max(1, (int)thread::hardware_concurrency());
+  for(int threads = 1; ; threads = min(threads * 2, cores)){
+    auto t1 = chrono::steady_clock::now();
+    ComponentIndex index(vertexCount, edges, threads);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - t1).count();
+    if(threads == 1){
+      cout << label << ": " << vertexCount << " vertices, " << edges.size() << " edges, "
+           << index.count() << " components" << endl;
+      cout << "  sequential union-find: " << sequentialSeconds * 1000 << " ms" << endl;
+    }
+    cout << "  " << threads << " threads: " << seconds * 1000 << " ms, speedup "
+         << sequentialSeconds / seconds << (index.component == expected ? "" : " (MISMATCH)") << endl;
+    if(threads == cores){
+      break;
+    }
+  }
+}
+
+// Usage: ./connected_components bench [side]
+//   road graph: side x side grid with 45% of roads kept, random graph: same
+//   vertex count, 0.7 edges per vertex
+int main(int argc, char* argv[]){
+
+  if(argc > 1 && string(argv[1]) == "bench"){
+    int side = argc > 2 ? stoi(argv[2]) : 1000;
+    int n = side * side;
+    speedupCurve("Sparse road grid", n, buildSparseGridEdges(side, 0.45, 42));
+    speedupCurve("Random graph", n, buildRandomEdges(n, n * 7 / 10, 42));
+    return 0;
+  }
+
+  // Graph structure (ids: A=0, B=1, C=2, D=3, E=4, F=5):
+  //   A --10--> B --15--> D      E --5--> F   (an island)
+  //    \                 /
+  //     5----> C --20---
+  vector<string> names = {"A", "B", "C", "D", "E", "F"};
+  vector<Edge> edges = {{0, 1, 10}, {0, 2, 5}, {1, 3, 15}, {2, 3, 20}, {4, 5, 5}};
+  ComponentIndex index(6, edges, 2);
+  cout << index.count() << " components" << endl;
+
+  for(auto query : {make_pair(0, 3), make_pair(0, 5)}){
+    cout << names[query.first] << " -> " << names[query.second] << ": "
+         << (index.mayBeConnected(query.first, query.second) ? "same component, search needed" : "no path (rejected in O(1))")
+         << endl;
+  }
+  return 0;
+}
@@ -0,0 +1,907 @@
+#include<iostream>
+#include<fstream>
+#include<unordered_map>
+#include<vector>
+#include<string>
+#include<algorithm>
+#include<queue>
+#include<thread>
+#include<atomic>
+#include<climits>
+#include<cstdint>
+#include<cstdio>
+#include<chrono>
+#include<random>
+using namespace std;
+
+// Contraction hierarchies (CH) for fast point-to-point routing
+//
+// Preprocessing removes ("contracts") vertices one at a time from least to
+// most important. When vertex v is removed, every shortest path u -> v -> x
+// that has no equally short detour (a "witness") is preserved by adding a
+// shortcut edge u -> x that remembers v as its middle vertex. Each vertex's
+// rank is its position in this order.
+//
+// A query then only ever moves to higher-ranked vertices: a forward search
+// from start over upward edges and a backward search from destination over
+// upward edges of the reversed graph. They meet at the highest vertex of the
+// shortest path. Shortcuts are unpacked recursively to recover the full route.
+
+// Class representing a node/vertex in the graph (same as map_navigation.cpp)
+class Place{
+  public:
+    string name;  // Name of the place
+    unordered_map<Place*, int> neighbours;  // Adjacency list: neighbour -> edge weight
+
+    Place(string name) : name(name) {}
+
+    string getName() const{
+      return name;
+    }
+
+    void addNeighbour(Place* neighbour, int distance){
+      neighbours[neighbour] = distance;
+    }
+
+    const unordered_map<Place*, int>& getNeighbours() const{
+      return neighbours;
+    }
+};
+
+// A single directed, weighted edge between two vertex ids
+struct Edge{
+  int from;
+  int to;
+  int weight;
+};
+
+// Gives dense ids to all places reachable from the given ones and collects
+// their edges. byId receives the id -> Place* mapping
+vector<Edge> edgesFromPlaces(const vector<Place*>& places, vector<Place*>& byId){
+  unordered_map<Place*, int> idOf;
+  byId.clear();
+  for(Place* place : places){
+    if(idOf.count(place) == 0){
+      idOf[place] = (int)byId.size();
+      byId.push_back(place);
+    }
+  }
+
+  vector<Edge> edges;
+  for(size_t i = 0; i < byId.size(); i++){
+    for(const auto& neighbor : byId[i]->getNeighbours()){
+      auto found = idOf.find(neighbor.first);
+      int to;
+      if(found == idOf.end()){
+        to = (int)byId.size();
+        idOf[neighbor.first] = to;
+        byId.push_back(neighbor.first);
+      }
+      else{
+        to = found->second;
+      }
+      edges.push_back({(int)i, to, neighbor.second});
+    }
+  }
+  return edges;
+}
+
+// Small Dijkstra state with generation stamps, reused across the many local
+// searches of preprocessing and across queries (see QueryWorkspace in
+// map_navigation.cpp)
+class SearchSpace{
+  public:
+    typedef pair<int, int> HeapEntry;  // (distance, vertex)
+
+    explicit SearchSpace(int vertexCount)
+      : distances(vertexCount), parents(vertexCount), stamps(vertexCount, 0), generation(0){}
+
+    void reset(){
+      generation++;
+      if(generation == 0){
+        fill(stamps.begin(), stamps.end(), 0);
+        generation = 1;
+      }
+      heap.clear();
+    }
+
+    int distance(int vertex) const{
+      return stamps[vertex] == generation ? distances[vertex] : INT_MAX;
+    }
+
+    // Predecessor vertex, -1 if none
+    int parent(int vertex) const{
+      return stamps[vertex] == generation ? parents[vertex] : -1;
+    }
+
+    void update(int vertex, int distance, int parent){
+      distances[vertex] = distance;
+      parents[vertex] = parent;
+      stamps[vertex] = generation;
+    }
+
+    bool heapEmpty() const{
+      return heap.empty();
+    }
+
+    int topDistance() const{
+      return heap.front().first;
+    }
+
+    void push(int distance, int vertex){
+      heap.push_back(HeapEntry(distance, vertex));
+      push_heap(heap.begin(), heap.end(), greater<HeapEntry>());
+    }
+
+    HeapEntry pop(){
+      pop_heap(heap.begin(), heap.end(), greater<HeapEntry>());
+      HeapEntry top = heap.back();
+      heap.pop_back();
+      return top;
+    }
+
+  private:
+    vector<int> distances;
+    vector<int> parents;
+    vector<unsigned> stamps;
+    vector<HeapEntry> heap;
+    unsigned generation;
+};
+
+// The finished hierarchy: vertex ranks plus two CSR graphs
+//   up:   edges v -> x with rank[x] > rank[v] (original edges and shortcuts)
+//   down: for every edge u -> v with rank[u] > rank[v], an entry at v
+//         pointing back to u, so a backward search from destination also
+//         only climbs in rank
+// middles[e] is the contracted vertex a shortcut skips, -1 for original edges
+class ContractionHierarchy{
+  public:
+    vector<int> rank;
+    vector<int> upOffsets, upTargets, upWeights, upMiddles;
+    vector<int> downOffsets, downTargets, downWeights, downMiddles;
+    vector<string> names;
+
+    int vertexCount() const{
+      return (int)rank.size();
+    }
+
+    string getName(int vertex) const{
+      return names.empty() ? to_string(vertex) : names[vertex];
+    }
+
+    // Writes the hierarchy to a versioned binary file so it does not have
+    // to be rebuilt on every start. Returns false if the file cannot be written
+    bool save(const string& path) const{
+      ofstream out(path, ios::binary);
+      if(!out){
+        return false;
+      }
+      uint32_t header[2] = {fileMagic, fileVersion};
+      out.write((const char*)header, sizeof(header));
+      writeArray(out, rank);
+      writeArray(out, upOffsets);
+      writeArray(out, upTargets);
+      writeArray(out, upWeights);
+      writeArray(out, upMiddles);
+      writeArray(out, downOffsets);
+      writeArray(out, downTargets);
+      writeArray(out, downWeights);
+      writeArray(out, downMiddles);
+      uint64_t nameCount = names.size();
+      out.write((const char*)&nameCount, sizeof(nameCount));
+      for(const string& name : names){
+        uint32_t length = (uint32_t)name.size();
+        out.write((const char*)&length, sizeof(length));
+        out.write(name.data(), length);
+      }
+      return (bool)out;
+    }
+
+    // Reads a hierarchy written by save(). Returns false (leaving this
+    // object unspecified) if the file is missing, from another version,
+    // truncated, or its arrays do not fit together
+    bool load(const string& path){
+      ifstream in(path, ios::binary);
+      if(!in){
+        return false;
+      }
+      uint32_t header[2];
+      if(!in.read((char*)header, sizeof(header)) || header[0] != fileMagic || header[1] != fileVersion){
+        return false;
+      }
+      if(!readArray(in, rank) || !readArray(in, upOffsets) || !readArray(in, upTargets)
+         || !readArray(in, upWeights) || !readArray(in, upMiddles) || !readArray(in, downOffsets)
+         || !readArray(in, downTargets) || !readArray(in, downWeights) || !readArray(in, downMiddles)){
+        return false;
+      }
+      uint64_t nameCount;
+      if(!in.read((char*)&nameCount, sizeof(nameCount)) || (nameCount != 0 && nameCount != rank.size())){
+        return false;
+      }
+      names.assign(nameCount, string());
+      for(string& name : names){
+        uint32_t length;
+        if(!in.read((char*)&length, sizeof(length))){
+          return false;
+        }
+        name.resize(length);
+        if(!in.read(&name[0], length)){
+          return false;
+        }
+      }
+      return isConsistent();
+    }
+
+  private:
+    static const uint32_t fileMagic = 0x31484343;  // "CCH1"
+    static const uint32_t fileVersion = 1;
+
+    static void writeArray(ofstream& out, const vector<int>& values){
+      uint64_t count = values.size();
+      out.write((const char*)&count, sizeof(count));
+      out.write((const char*)values.data(), count * sizeof(int));
+    }
+
+    static bool readArray(ifstream& in, vector<int>& values){
+      uint64_t count;
+      if(!in.read((char*)&count, sizeof(count)) || count > (1ull << 34)){
+        return false;
+      }
+      values.resize(count);
+      return (bool)in.read((char*)values.data(), count * sizeof(int));
+    }
+
+    // Checks array sizes, that every edge index and target is in range, that
+    // rank is a permutation, and that every shortcut middle ranks below both
+    // ends of its edge (true by construction), which bounds unpackEdge()'s
+    // recursion on a corrupt file
+    bool isConsistent() const{
+      size_t n = rank.size();
+      vector<char> rankUsed(n, 0);
+      for(size_t v = 0; v < n; v++){
+        if(rank[v] < 0 || (size_t)rank[v] >= n || rankUsed[rank[v]]){
+          return false;
+        }
+        rankUsed[rank[v]] = 1;
+      }
+      if(upOffsets.size() != n + 1 || downOffsets.size() != n + 1){
+        return false;
+      }
+      size_t ups = upTargets.size(), downs = downTargets.size();
+      if(upWeights.size() != ups || upMiddles.size() != ups || downWeights.size() != downs || downMiddles.size() != downs){
+        return false;
+      }
+      if(upOffsets[0] != 0 || (size_t)upOffsets[n] != ups || downOffsets[0] != 0 || (size_t)downOffsets[n] != downs){
+        return false;
+      }
+      for(size_t v = 0; v < n; v++){
+        if(upOffsets[v] > upOffsets[v + 1] || downOffsets[v] > downOffsets[v + 1]){
+          return false;
+        }
+      }
+      for(size_t e = 0; e < ups; e++){
+        if(upTargets[e] < 0 || (size_t)upTargets[e] >= n || upMiddles[e] < -1 || upMiddles[e] >= (int)n){
+          return false;
+        }
+      }
+      for(size_t e = 0; e < downs; e++){
+        if(downTargets[e] < 0 || (size_t)downTargets[e] >= n || downMiddles[e] < -1 || downMiddles[e] >= (int)n){
+          return false;
+        }
+      }
+      for(size_t v = 0; v < n; v++){
+        for(int e = upOffsets[v]; e < upOffsets[v + 1]; e++){
+          if(!middleRanksBelow(upMiddles[e], (int)v, upTargets[e])){
+            return false;
+          }
+        }
+        for(int e = downOffsets[v]; e < downOffsets[v + 1]; e++){
+          if(!middleRanksBelow(downMiddles[e], (int)v, downTargets[e])){
+            return false;
+          }
+        }
+      }
+      return true;
+    }
+
+    // True for original edges (middle -1) and for shortcuts whose middle
+    // ranks below both endpoints
+    bool middleRanksBelow(int middle, int u, int x) const{
+      return middle == -1 || (rank[middle] < rank[u] && rank[middle] < rank[x]);
+    }
+};
+
+// Calls body(thread, items[i]) for every item, handed out in chunks to threadCount threads
+template<typename Body>
+static void runParallel(int threadCount, const vector<int>& items, const Body& body){
+  const size_t chunk = 16;  // Items are witness searches: small chunks balance well
+  atomic<size_t> next(0);
+  auto worker = [&](int thread){
+    for(size_t begin = next.fetch_add(chunk); begin < items.size(); begin = next.fetch_add(chunk)){
+      size_t end = min(items.size(), begin + chunk);
+      for(size_t i = begin; i < end; i++){
+        body(thread, items[i]);
+      }
+    }
+  };
+  threadCount = max(1, min(threadCount, (int)((items.size() + chunk - 1) / chunk)));
+  vector<std::thread> threads;
+  for(int t = 1; t < threadCount; t++){
+    threads.push_back(std::thread(worker, t));
+  }
+  worker(0);
+  for(std::thread& t : threads){
+    t.join();
+  }
+}
+
+// Builds a ContractionHierarchy from an edge list
+// Node order: "edge difference" heuristic. A vertex's priority is the number
+// of shortcuts its contraction would add, minus the edges it removes, plus
+// how many of its neighbours were already contracted (spreads contraction
+// evenly); lower priorities are contracted first.
+// Contraction runs in rounds, all witness searches in parallel:
+//   1. candidates are the remaining vertices whose (priority, id) is below
+//      that of all their remaining neighbours. Priorities are updated
+//      lazily: a candidate whose neighbourhood changed since its priority
+//      was computed is recomputed now, and the candidates that are still
+//      local minima form the round's independent set (no two are adjacent)
+//   2. the set is marked contracted and the shortcuts of all its vertices
+//      are found in parallel; witness searches avoid the whole set, so each
+//      only sees edges that survive the round (a missed witness only adds a
+//      harmless shortcut)
+//   3. the shortcuts are inserted, ranks assigned, and the set's remaining
+//      neighbours marked as needing a new priority
+class HierarchyBuilder{
+  public:
+    HierarchyBuilder(int vertexCount, const vector<Edge>& edges)
+      : n(vertexCount), out(vertexCount), in(vertexCount), contracted(vertexCount, 0),
+        contractedNeighbours(vertexCount, 0){
+      for(const Edge& edge : edges){
+        if(edge.from != edge.to){
+          addOrLowerEdge(edge.from, edge.to, edge.weight, -1);
+        }
+      }
+    }
+
+    ContractionHierarchy build(int threadCount){
+      ContractionHierarchy hierarchy;
+      hierarchy.rank.assign(n, -1);
+      vector<vector<Arc> > upward(n), downward(n);
+      threadCount = max(1, threadCount);
+      vector<SearchSpace> spaces(threadCount, SearchSpace(n));
+
+      vector<int> remaining(n);
+      for(int v = 0; v < n; v++){
+        remaining[v] = v;
+      }
+      vector<int> priority(n);
+      runParallel(threadCount, remaining, [&](int thread, int v){
+        priority[v] = computePriority(v, spaces[thread]);
+      });
+
+      vector<char> candidate(n, 0), stale(n, 0);
+      vector<int> candidates, recompute, batch;
+      vector<vector<Shortcut> > shortcuts(threadCount);
+      int nextRank = 0;
+      while(!remaining.empty()){
+        // 1. Local minima, refreshed if stale, then checked again against
+        // the refreshed priorities. If every candidate was stale the set
+        // may come out empty, but the next round then has fewer stale ones
+        runParallel(threadCount, remaining, [&](int, int v){
+          candidate[v] = isLocalMinimum(v, priority);
+        });
+        candidates.clear();
+        recompute.clear();
+        for(int v : remaining){
+          if(candidate[v]){
+            candidates.push_back(v);
+            if(stale[v]){
+              recompute.push_back(v);
+              stale[v] = 0;
+            }
+          }
+        }
+        runParallel(threadCount, recompute, [&](int thread, int v){
+          priority[v] = computePriority(v, spaces[thread]);
+        });
+        batch.clear();
+        for(int v : candidates){
+          if(isLocalMinimum(v, priority)){
+            batch.push_back(v);
+          }
+        }
+
+        // 2. Shortcuts of the whole set against the graph without it
+        for(int v : batch){
+          contracted[v] = 1;
+        }
+        runParallel(threadCount, batch, [&](int thread, int v){
+          forEachShortcut(v, spaces[thread], [&](int u, int x, int weight){
+            shortcuts[thread].push_back({u, x, weight, v});
+          });
+        });
+
+        // 3. Remaining edges of the set all lead to higher-ranked vertices
+        for(int v : batch){
+          for(const Arc& arc : out[v]){
+            if(!contracted[arc.to]){
+              upward[v].push_back(arc);
+              contractedNeighbours[arc.to]++;
+              stale[arc.to] = 1;
+            }
+          }
+          for(const Arc& arc : in[v]){
+            if(!contracted[arc.to]){
+              downward[v].push_back(arc);
+              contractedNeighbours[arc.to]++;
+              stale[arc.to] = 1;
+            }
+          }
+          hierarchy.rank[v] = nextRank++;
+        }
+        for(vector<Shortcut>& list : shortcuts){
+          for(const Shortcut& shortcut : list){
+            addOrLowerEdge(shortcut.from, shortcut.to, shortcut.weight, shortcut.middle);
+          }
+          list.clear();
+        }
+
+        size_t kept = 0;
+        for(int v : remaining){
+          if(!contracted[v]){
+            remaining[kept++] = v;
+          }
+        }
+        remaining.resize(kept);
+      }
+
+      flatten(upward, hierarchy.upOffsets, hierarchy.upTargets, hierarchy.upWeights, hierarchy.upMiddles);
+      flatten(downward, hierarchy.downOffsets, hierarchy.downTargets, hierarchy.downWeights, hierarchy.downMiddles);
+      return hierarchy;
+    }
+
+  private:
+    // Adjacency entry during contraction: neighbour, weight, shortcut middle
+    struct Arc{
+      int to;
+      int weight;
+      int middle;
+    };
+
+    // Shortcut u -> x found while contracting middle
+    struct Shortcut{
+      int from;
+      int to;
+      int weight;
+      int middle;
+    };
+
+    static const int witnessSettleLimit = 500;  // Bounds each local witness search
+
+    int n;
+    vector<vector<Arc> > out;   // out[v]: edges v -> to
+    vector<vector<Arc> > in;    // in[v]:  edges to -> v (stored at the head)
+    vector<char> contracted;  // Bytes, not vector<bool>: read while other threads run
+    vector<int> contractedNeighbours;
+
+    // Inserts u -> x, or lowers the weight of an existing u -> x edge
+    void addOrLowerEdge(int u, int x, int weight, int middle){
+      for(Arc& arc : out[u]){
+        if(arc.to == x){
+          if(weight < arc.weight){
+            arc.weight = weight;
+            arc.middle = middle;
+            for(Arc& back : in[x]){
+              if(back.to == u){
+                back.weight = weight;
+                back.middle = middle;
+              }
+            }
+          }
+          return;
+        }
+      }
+      out[u].push_back({x, weight, middle});
+      in[x].push_back({u, weight, middle});
+    }
+
+    // Local Dijkstra from source in the remaining graph, skipping the vertex
+    // being contracted. Stops past limit or after witnessSettleLimit pops;
+    // an unfinished search only causes extra (harmless) shortcuts
+    void witnessSearch(int source, int skipped, int limit, SearchSpace& space) const{
+      space.reset();
+      space.update(source, 0, -1);
+      space.push(0, source);
+      int settled = 0;
+      while(!space.heapEmpty() && settled < witnessSettleLimit){
+        SearchSpace::HeapEntry top = space.pop();
+        if(top.first > space.distance(top.second)){
+          continue;
+        }
+        if(top.first > limit){
+          break;
+        }
+        settled++;
+        for(const Arc& arc : out[top.second]){
+          if(arc.to == skipped || contracted[arc.to]){
+            continue;
+          }
+          int newDistance = top.first + arc.weight;
+          if(newDistance < space.distance(arc.to)){
+            space.update(arc.to, newDistance, top.second);
+            space.push(newDistance, arc.to);
+          }
+        }
+      }
+    }
+
+    // Visits every shortcut that contracting v needs: calls emit(u, x, weight)
+    // for each in-neighbour u and out-neighbour x without a witness path
+    template<typename Emit>
+    void forEachShortcut(int v, SearchSpace& space, Emit emit) const{
+      int maxOut = 0;
+      for(const Arc& arc : out[v]){
+        if(!contracted[arc.to]){
+          maxOut = max(maxOut, arc.weight);
+        }
+      }
+      for(const Arc& incoming : in[v]){
+        int u = incoming.to;
+        if(contracted[u]){
+          continue;
+        }
+        witnessSearch(u, v, incoming.weight + maxOut, space);
+        for(const Arc& outgoing : out[v]){
+          int x = outgoing.to;
+          if(contracted[x] || x == u){
+            continue;
+          }
+          int viaV = incoming.weight + outgoing.weight;
+          if(space.distance(x) > viaV){
+            emit(u, x, viaV);
+          }
+        }
+      }
+    }
+
+    // Edge difference plus contracted-neighbour count (lower = contract earlier)
+    int computePriority(int v, SearchSpace& space) const{
+      int shortcuts = 0;
+      forEachShortcut(v, space, [&shortcuts](int, int, int){ shortcuts++; });
+      int removed = 0;
+      for(const Arc& arc : out[v]){
+        removed += !contracted[arc.to];
+      }
+      for(const Arc& arc : in[v]){
+        removed += !contracted[arc.to];
+      }
+      return shortcuts - removed + contractedNeighbours[v];
+    }
+
+    // True if v orders before every remaining neighbour by (priority, id)
+    bool isLocalMinimum(int v, const vector<int>& priority) const{
+      for(const vector<Arc>* arcs : {&out[v], &in[v]}){
+        for(const Arc& arc : *arcs){
+          int w = arc.to;
+          if(!contracted[w] && (priority[w] < priority[v] || (priority[w] == priority[v] && w < v))){
+            return false;
+          }
+        }
+      }
+      return true;
+    }
+
+    static void flatten(const vector<vector<Arc> >& lists, vector<int>& offsets, vector<int>& targets,
+                        vector<int>& weights, vector<int>& middles){
+      offsets.assign(1, 0);
+      for(const vector<Arc>& list : lists){
+        for(const Arc& arc : list){
+          targets.push_back(arc.to);
+          weights.push_back(arc.weight);
+          middles.push_back(arc.middle);
+        }
+        offsets.push_back((int)targets.size());
+      }
+    }
+};
+
+// State for CH queries; reuse one per thread
+struct HierarchyWorkspace{
+  SearchSpace forward;
+  SearchSpace backward;
+  int meeting;
+
+  explicit HierarchyWorkspace(int vertexCount) : forward(vertexCount), backward(vertexCount), meeting(-1){}
+};
+
+// Settles one vertex of an upward search and relaxes its upward edges
+static void upwardStep(const vector<int>& offsets, const vector<int>& targets, const vector<int>& weights,
+                       SearchSpace& self, const SearchSpace& other, int& best, int& meeting){
+  SearchSpace::HeapEntry top = self.pop();
+  int current = top.second;
+  if(top.first > self.distance(current)){
+    return;
+  }
+  int otherDistance = other.distance(current);
+  if(otherDistance != INT_MAX && top.first + otherDistance < best){
+    best = top.first + otherDistance;
+    meeting = current;
+  }
+  for(int e = offsets[current]; e < offsets[current + 1]; e++){
+    int newDistance = top.first + weights[e];
+    if(newDistance < self.distance(targets[e])){
+      self.update(targets[e], newDistance, current);
+      self.push(newDistance, targets[e]);
+    }
+  }
+}
+
+// Shortest distance from start to destination using only upward edges on
+// both sides. A side stops once its smallest key reaches the best meeting
+// distance found so far
+// Returns: distance, INT_MAX if unreachable
+int findShortestPath(const ContractionHierarchy& hierarchy, int start, int destination, HierarchyWorkspace& workspace){
+  SearchSpace& forward = workspace.forward;
+  SearchSpace& backward = workspace.backward;
+  forward.reset();
+  backward.reset();
+  forward.update(start, 0, -1);
+  forward.push(0, start);
+  backward.update(destination, 0, -1);
+  backward.push(0, destination);
+
+  int best = INT_MAX;
+  workspace.meeting = -1;
+  for(;;){
+    bool forwardOpen = !forward.heapEmpty() && forward.topDistance() < best;
+    bool backwardOpen = !backward.heapEmpty() && backward.topDistance() < best;
+    if(!forwardOpen && !backwardOpen){
+      break;
+    }
+    if(forwardOpen && (!backwardOpen || forward.topDistance() <= backward.topDistance())){
+      upwardStep(hierarchy.upOffsets, hierarchy.upTargets, hierarchy.upWeights, forward, backward, best, workspace.meeting);
+    }
+    else{
+      upwardStep(hierarchy.downOffsets, hierarchy.downTargets, hierarchy.downWeights, backward, forward, best, workspace.meeting);
+    }
+  }
+  return best;
+}
+
+// Middle vertex of the lightest hierarchy edge from -> to
+static int edgeMiddle(const ContractionHierarchy& hierarchy, int from, int to){
+  int bestWeight = INT_MAX, middle = -1;
+  if(hierarchy.rank[from] < hierarchy.rank[to]){
+    for(int e = hierarchy.upOffsets[from]; e < hierarchy.upOffsets[from + 1]; e++){
+      if(hierarchy.upTargets[e] == to && hierarchy.upWeights[e] < bestWeight){
+        bestWeight = hierarchy.upWeights[e];
+        middle = hierarchy.upMiddles[e];
+      }
+    }
+  }
+  else{
+    for(int e = hierarchy.downOffsets[to]; e < hierarchy.downOffsets[to + 1]; e++){
+      if(hierarchy.downTargets[e] == from && hierarchy.downWeights[e] < bestWeight){
+        bestWeight = hierarchy.downWeights[e];
+        middle = hierarchy.downMiddles[e];
+      }
+    }
+  }
+  return middle;
+}
+
+// Appends the original vertices of edge from -> to (excluding from) to path,
+// replacing each shortcut by the two edges it was built from
+static void unpackEdge(const ContractionHierarchy& hierarchy, int from, int to, int middle, vector<int>& path){
+  if(middle == -1){
+    path.push_back(to);
+    return;
+  }
+  unpackEdge(hierarchy, from, middle, edgeMiddle(hierarchy, from, middle), path);
+  unpackEdge(hierarchy, middle, to, edgeMiddle(hierarchy, middle, to), path);
+}
+
+// Writes the unpacked vertex path of the last query into path
+// Returns: number of vertices on the path, 0 if destination was not reached
+size_t reconstructPath(const ContractionHierarchy& hierarchy, int start, int destination,
+                       const HierarchyWorkspace& workspace, vector<int>& path){
+  path.clear();
+  if(workspace.meeting == -1){
+    return 0;
+  }
+
+  // Upward half start -> meeting: collect the hierarchy vertices backwards,
+  // then unpack each edge in forward order
+  vector<int> upward;
+  for(int v = workspace.meeting; v != -1; v = workspace.forward.parent(v)){
+    upward.push_back(v);
+  }
+  reverse(upward.begin(), upward.end());
+  path.push_back(start);
+  for(size_t i = 0; i + 1 < upward.size(); i++){
+    unpackEdge(hierarchy, upward[i], upward[i + 1], edgeMiddle(hierarchy, upward[i], upward[i + 1]), path);
+  }
+
+  // Downward half meeting -> destination: backward parents point the right way
+  for(int v = workspace.meeting; v != destination; ){
+    int next = workspace.backward.parent(v);
+    unpackEdge(hierarchy, v, next, edgeMiddle(hierarchy, v, next), path);
+    v = next;
+  }
+  return path.size();
+}
+
+// Plain Dijkstra over an edge list, used as the reference in runBenchmark()
+class ReferenceDijkstra{
+  public:
+    ReferenceDijkstra(int vertexCount, const vector<Edge>& edges)
+      : offsets(vertexCount + 1, 0), targets(edges.size()), weights(edges.size()), space(vertexCount){
+      for(const Edge& edge : edges){
+        offsets[edge.from + 1]++;
+      }
+      for(int v = 0; v < vertexCount; v++){
+        offsets[v + 1] += offsets[v];
+      }
+      vector<int> next(offsets.begin(), offsets.end() - 1);
+      for(const Edge& edge : edges){
+        targets[next[edge.from]] = edge.to;
+        weights[next[edge.from]++] = edge.weight;
+      }
+    }
+
+    int distance(int start, int destination){
+      space.reset();
+      space.update(start, 0, -1);
+      space.push(0, start);
+      while(!space.heapEmpty()){
+        SearchSpace::HeapEntry top = space.pop();
+        if(top.first > space.distance(top.second)){
+          continue;
+        }
+        if(top.second == destination){
+          return top.first;
+        }
+        for(int e = offsets[top.second]; e < offsets[top.second + 1]; e++){
+          int newDistance = top.first + weights[e];
+          if(newDistance < space.distance(targets[e])){
+            space.update(targets[e], newDistance, top.second);
+            space.push(newDistance, targets[e]);
+          }
+        }
+      }
+      return INT_MAX;
+    }
+
+  private:
+    vector<int> offsets, targets, weights;
+    SearchSpace space;
+};
+
+// Road-like side x side grid with random weights in [1, 100] in both directions
+vector<Edge> buildGridEdges(int side, unsigned seed){
+  mt19937 rng(seed);
+  uniform_int_distribution<int> weight(1, 100);
+  vector<Edge> edges;
+  for(int row = 0; row < side; row++){
+    for(int col = 0; col < side; col++){
+      int here = row * side + col;
+      if(col + 1 < side){
+        int w = weight(rng);
+        edges.push_back({here, here + 1, w});
+        edges.push_back({here + 1, here, w});
+      }
+      if(row + 1 < side){
+        int w = weight(rng);
+        edges.push_back({here, here + side, w});
+        edges.push_back({here + side, here, w});
+      }
+    }
+  }
+  return edges;
+}
+
+// Times preprocessing, a save/load round trip and CH queries against plain
+// Dijkstra on a grid graph, checking every distance and unpacked path
+// Usage: ./contraction_hierarchies bench [side] [queries]
+void runBenchmark(int side, int queries){
+  int n = side * side;
+  vector<Edge> edges = buildGridEdges(side, 42);
+  int threads = max(1, (int)thread::hardware_concurrency());
+
+  auto t0 = chrono::steady_clock::now();
+  ContractionHierarchy hierarchy = HierarchyBuilder(n, edges).build(threads);
+  auto t1 = chrono::steady_clock::now();
+  hierarchy.save("ch_bench.bin");
+  ContractionHierarchy loaded;
+  bool loadedOk = loaded.load("ch_bench.bin");
+  auto t2 = chrono::steady_clock::now();
+  remove("ch_bench.bin");
+
+  // Lookup of original edge weights to validate unpacked paths
+  unordered_map<long long, int> weightOf;
+  for(const Edge& edge : edges){
+    weightOf[(long long)edge.from * n + edge.to] = edge.weight;
+  }
+
+  ReferenceDijkstra reference(n, edges);
+  HierarchyWorkspace workspace(n);
+  vector<int> path;
+  mt19937 rng(7);
+  double chSeconds = 0, dijkstraSeconds = 0;
+  int mismatches = 0;
+  for(int q = 0; q < queries; q++){
+    int from = rng() % n, to = rng() % n;
+    auto q0 = chrono::steady_clock::now();
+    int chDistance = findShortestPath(loaded, from, to, workspace);
+    reconstructPath(loaded, from, to, workspace, path);
+    auto q1 = chrono::steady_clock::now();
+    int expected = reference.distance(from, to);
+    auto q2 = chrono::steady_clock::now();
+    chSeconds += chrono::duration<double>(q1 - q0).count();
+    dijkstraSeconds += chrono::duration<double>(q2 - q1).count();
+
+    long long pathLength = 0;
+    for(size_t i = 0; i + 1 < path.size(); i++){
+      auto found = weightOf.find((long long)path[i] * n + path[i + 1]);
+      pathLength += found == weightOf.end() ? (long long)INT_MAX : found->second;
+    }
+    if(chDistance != expected || pathLength != expected || path.front() != from || path.back() != to){
+      mismatches++;
+    }
+  }
+
+  cout << "Grid " << side << "x" << side << ", " << edges.size() << " edges, " << threads << " threads" << endl;
+  cout << "  preprocessing: " << chrono::duration<double>(t1 - t0).count() * 1000 << " ms, "
+       << hierarchy.upTargets.size() + hierarchy.downTargets.size() << " hierarchy edges" << endl;
+  cout << "  save + load:   " << chrono::duration<double>(t2 - t1).count() * 1000 << " ms"
+       << (loadedOk ? "" : " (load FAILED)") << endl;
+  cout << "  CH query:      " << chSeconds * 1e6 / queries << " us/query (incl. unpacking)" << endl;
+  cout << "  Dijkstra:      " << dijkstraSeconds * 1e6 / queries << " us/query" << endl;
+  cout << "  mismatches:    " << mismatches << endl;
+}
+
+// Main function: contracts the small example map and routes through it
+int main(int argc, char* argv[]){
+
+  if(argc > 1 && string(argv[1]) == "bench"){
+    int side = argc > 2 ? stoi(argv[2]) : 200;
+    int queries = argc > 3 ? stoi(argv[3]) : 1000;
+    runBenchmark(side, queries);
+    return 0;
+  }
+
+  // Graph structure:
+  //   A --10--> B --15--> D --3--> E
+  //    \                 /
+  //     5----> C --20---
+  Place a("A"), b("B"), c("C"), d("D"), e("E");
+  a.addNeighbour(&b, 10);
+  a.addNeighbour(&c, 5);
+  b.addNeighbour(&d, 15);
+  c.addNeighbour(&d, 20);
+  d.addNeighbour(&e, 3);
+
+  vector<Place*> byId;
+  vector<Edge> edges = edgesFromPlaces({&a}, byId);
+  ContractionHierarchy hierarchy = HierarchyBuilder((int)byId.size(), edges).build(2);
+  for(Place* place : byId){
+    hierarchy.names.push_back(place->getName());
+  }
+
+  HierarchyWorkspace workspace(hierarchy.vertexCount());
+  vector<int> path;
+  int start = 0;  // A was passed first, so it has id 0
+  int destination = (int)(find(byId.begin(), byId.end(), &e) - byId.begin());
+  int distance = findShortestPath(hierarchy, start, destination, workspace);
+  reconstructPath(hierarchy, start, destination, workspace, path);
+
+  cout << "Shortest distance A to E: " << distance << endl;
+  cout << "Shortest Path:" << endl;
+  for(int vertex : path){
+    cout << byId[vertex]->getName() << " -> ";
+  }
+  cout << "Destination" << endl;
+
+  return 0;
+}
@@ -0,0 +1,367 @@
+#include<iostream>
+#include<vector>
+#include<string>
+#include<algorithm>
+#include<queue>
+#include<thread>
+#include<mutex>
+#include<condition_variable>
+#include<atomic>
+#include<climits>
+#include<chrono>
+#include<random>
+#include<stdexcept>
+using namespace std;
+
+// Parallel delta-stepping single-source shortest paths
+//
+// Tentative distances are grouped into buckets of width delta: bucket i holds
+// vertices whose distance lies in [i * delta, (i + 1) * delta). The smallest
+// non-empty bucket is processed in rounds. Each round relaxes the "light"
+// edges (weight < delta) of all its vertices in parallel; a light edge can
+// only re-insert vertices into the same bucket, so rounds repeat until the
+// bucket stays empty. Then the "heavy" edges of every vertex that passed
+// through the bucket are relaxed once, which can only fill later buckets.
+//
+// A large delta means few buckets with lots of parallel work per round but
+// some wasted relaxations; delta = 1 degenerates to Dijkstra. Distance
+// updates use an atomic compare-and-swap minimum, so the result is exactly
+// the Dijkstra result regardless of thread interleaving.
+
+// A single directed, weighted edge between two vertex ids
+struct Edge{
+  int from;
+  int to;
+  int weight;
+};
+
+// CSR graph (as in map_navigation.cpp) whose edge range of every vertex is
+// split by a delta: light edges first, heavy edges from lightEnd[v] on
+class SplitCsrGraph{
+  public:
+    vector<int> offsets;   // Size V + 1
+    vector<int> lightEnd;  // Size V: first heavy edge of each vertex
+    vector<int> targets;   // Size E
+    vector<int> weights;   // Size E
+    int delta;
+
+    // delta must be at least 1: it sizes the bucket ring in deltaStepping()
+    SplitCsrGraph(int vertexCount, const vector<Edge>& edges, int delta)
+      : offsets(vertexCount + 1, 0), lightEnd(vertexCount), delta(delta){
+      if(delta < 1){
+        throw invalid_argument("delta must be at least 1, got " + to_string(delta));
+      }
+      for(const Edge& edge : edges){
+        offsets[edge.from + 1]++;
+      }
+      for(int v = 0; v < vertexCount; v++){
+        offsets[v + 1] += offsets[v];
+      }
+
+      // Light edges fill each range from the front, heavy ones from the back
+      targets.resize(edges.size());
+      weights.resize(edges.size());
+      vector<int> front(offsets.begin(), offsets.end() - 1);
+      vector<int> back(offsets.begin() + 1, offsets.end());
+      for(const Edge& edge : edges){
+        int slot = edge.weight < delta ? front[edge.from]++ : --back[edge.from];
+        targets[slot] = edge.to;
+        weights[slot] = edge.weight;
+      }
+      for(int v = 0; v < vertexCount; v++){
+        lightEnd[v] = front[v];
+      }
+    }
+
+    int vertexCount() const{
+      return (int)offsets.size() - 1;
+    }
+};
+
+// Reusable barrier for a fixed number of threads
+class Barrier{
+  public:
+    explicit Barrier(int threadCount) : threadCount(threadCount), waiting(0), generation(0){}
+
+    void wait(){
+      unique_lock<mutex> lock(m);
+      unsigned arrived = generation;
+      if(++waiting == threadCount){
+        waiting = 0;
+        generation++;
+        released.notify_all();
+        return;
+      }
+      released.wait(lock, [this, arrived](){ return generation != arrived; });
+    }
+
+  private:
+    mutex m;
+    condition_variable released;
+    int threadCount;
+    int waiting;
+    unsigned generation;
+};
+
+// Lowers slot to value if value is smaller; returns true if it did
+static bool atomicMin(atomic<int>& slot, int value){
+  int current = slot.load(memory_order_relaxed);
+  while(value < current){
+    if(slot.compare_exchange_weak(current, value, memory_order_relaxed)){
+      return true;
+    }
+  }
+  return false;
+}
+
+// One-to-all shortest paths from source with threadCount threads
+// Returns: distance of every vertex, INT_MAX if unreachable
+vector<int> deltaStepping(const SplitCsrGraph& graph, int source, int threadCount){
+  int n = graph.vertexCount();
+  int delta = graph.delta;
+  threadCount = max(1, threadCount);
+
+  vector<atomic<int> > distances(n);
+  for(atomic<int>& distance : distances){
+    distance.store(INT_MAX, memory_order_relaxed);
+  }
+  distances[source].store(0, memory_order_relaxed);
+
+  // Pending entries only ever span maxWeight / delta + 1 buckets ahead of the
+  // current one, so buckets are kept in a ring of that size
+  int maxWeight = 0;
+  for(int weight : graph.weights){
+    maxWeight = max(maxWeight, weight);
+  }
+  size_t ringSize = (size_t)maxWeight / delta + 2;
+  vector<vector<int> > buckets(ringSize);
+  buckets[0].push_back(source);
+  size_t pending = 1;          // Entries in all buckets, stale ones included
+  long long currentBucket = 0;
+
+  // Shared round state, written by thread 0 between the two barriers
+  vector<int> frontier;        // Vertices to relax this round
+  bool heavyRound = false;
+  bool finished = false;
+  vector<int> bucketMembers;   // Every vertex settled into the current bucket
+  vector<long long> memberOf(n, -1);
+  vector<long long> frontierRound(n, -1);
+  long long round = 0;
+
+  // Per-thread lists of improved vertices, merged into buckets by thread 0
+  vector<vector<int> > improved(threadCount);
+  atomic<size_t> nextChunk(0);
+  const size_t chunkSize = 64;
+  Barrier barrier(threadCount);
+
+  // Thread 0 only: pick what the next round relaxes
+  auto planRound = [&](){
+    // Merge the last round's improvements into their buckets
+    for(vector<int>& list : improved){
+      for(int v : list){
+        int d = distances[v].load(memory_order_relaxed);
+        buckets[(size_t)(d / delta) % ringSize].push_back(v);
+        pending++;
+      }
+      list.clear();
+    }
+
+    for(;;){
+      // Light round on whatever is (again) in the current bucket, skipping
+      // stale entries of vertices that have since moved to a lower bucket
+      vector<int>& bucket = buckets[(size_t)currentBucket % ringSize];
+      if(!bucket.empty()){
+        frontier.clear();
+        round++;
+        for(int v : bucket){
+          int d = distances[v].load(memory_order_relaxed);
+          if(d / delta == currentBucket && frontierRound[v] != round){
+            frontierRound[v] = round;
+            frontier.push_back(v);
+            if(memberOf[v] != currentBucket){
+              memberOf[v] = currentBucket;
+              bucketMembers.push_back(v);
+            }
+          }
+        }
+        pending -= bucket.size();
+        bucket.clear();
+        if(!frontier.empty()){
+          heavyRound = false;
+          return;
+        }
+        continue;
+      }
+
+      // Bucket is stable: relax the heavy edges of everything that passed
+      // through it, once. Those can only reach later buckets
+      if(!bucketMembers.empty()){
+        frontier.swap(bucketMembers);
+        bucketMembers.clear();
+        heavyRound = true;
+        return;
+      }
+
+      if(pending == 0){
+        finished = true;
+        return;
+      }
+      currentBucket++;
+    }
+  };
+
+  auto worker = [&](int index){
+    for(;;){
+      if(index == 0){
+        planRound();
+        nextChunk.store(0, memory_order_relaxed);
+      }
+      barrier.wait();
+      if(finished){
+        return;
+      }
+
+      // Relax the chosen edge class of the frontier in chunks
+      vector<int>& mine = improved[index];
+      for(size_t begin = nextChunk.fetch_add(chunkSize); begin < frontier.size(); begin = nextChunk.fetch_add(chunkSize)){
+        size_t end = min(frontier.size(), begin + chunkSize);
+        for(size_t i = begin; i < end; i++){
+          int u = frontier[i];
+          int du = distances[u].load(memory_order_relaxed);
+          int first = heavyRound ? graph.lightEnd[u] : graph.offsets[u];
+          int last = heavyRound ? graph.offsets[u + 1] : graph.lightEnd[u];
+          for(int e = first; e < last; e++){
+            if(atomicMin(distances[graph.targets[e]], du + graph.weights[e])){
+              mine.push_back(graph.targets[e]);
+            }
+          }
+        }
+      }
+      barrier.wait();
+    }
+  };
+
+  vector<thread> threads;
+  for(int t = 1; t < threadCount; t++){
+    threads.push_back(thread(worker, t));
+  }
+  worker(0);
+  for(thread& t : threads){
+    t.join();
+  }
+
+  vector<int> result(n);
+  for(int v = 0; v < n; v++){
+    result[v] = distances[v].load(memory_order_relaxed);
+  }
+  return result;
+}
+
+// Sequential Dijkstra reference over the same graph
+vector<int> dijkstra(const SplitCsrGraph& graph, int source){
+  vector<int> distances(graph.vertexCount(), INT_MAX);
+  typedef pair<int, int> HeapEntry;
+  priority_queue<HeapEntry, vector<HeapEntry>, greater<HeapEntry> > frontier;
+  distances[source] = 0;
+  frontier.push(HeapEntry(0, source));
+  while(!frontier.empty()){
+    HeapEntry top = frontier.top();
+    frontier.pop();
+    if(top.first > distances[top.second]){
+      continue;
+    }
+    for(int e = graph.offsets[top.second]; e < graph.offsets[top.second + 1]; e++){
+      int newDistance = top.first + graph.weights[e];
+      if(newDistance < distances[graph.targets[e]]){
+        distances[graph.targets[e]] = newDistance;
+        frontier.push(HeapEntry(newDistance, graph.targets[e]));
+      }
+    }
+  }
+  return distances;
+}
+
+// Road-like side x side grid with random weights in [1, 100] in both directions
+vector<Edge> buildGridEdges(int side, unsigned seed){
+  mt19937 rng(seed);
+  uniform_int_distribution<int> weight(1, 100);
+  vector<Edge> edges;
+  for(int row = 0; row < side; row++){
+    for(int col = 0; col < side; col++){
+      int here = row * side + col;
+      if(col + 1 < side){
+        int w = weight(rng);
+        edges.push_back({here, here + 1, w});
+        edges.push_back({here + 1, here, w});
+      }
+      if(row + 1 < side){
+        int w = weight(rng);
+        edges.push_back({here, here + side, w});
+        edges.push_back({here + side, here, w});
+      }
+    }
+  }
+  return edges;
+}
+
+// Uniform random directed graph with weights in [1, 100]
+vector<Edge> buildRandomEdges(int vertexCount, int edgeCount, unsigned seed){
+  mt19937 rng(seed);
+  uniform_int_distribution<int> vertex(0, vertexCount - 1);
+  uniform_int_distribution<int> weight(1, 100);
+  vector<Edge> edges(edgeCount);
+  for(Edge& edge : edges){
+    edge = {vertex(rng), vertex(rng), weight(rng)};
+  }
+  return edges;
+}
+
+// Prints one speedup curve: time for 1, 2, 4, ... 64 threads relative to
+// the sequential Dijkstra, checking every result for an exact match
+void speedupCurve(const string& label, int vertexCount, const vector<Edge>& edges, int delta){
+  SplitCsrGraph graph(vertexCount, edges, delta);
+  auto t0 = chrono::steady_clock::now();
+  vector<int> expected = dijkstra(graph, 0);
+  double dijkstraSeconds = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+
+  cout << label << ": " << vertexCount << " vertices, " << edges.size() << " edges, delta " << delta << endl;
+  cout << "  Dijkstra: " << dijkstraSeconds * 1000 << " ms" << endl;
+  for(int threads = 1; threads <= 64; threads *= 2){
+    auto t1 = chrono::steady_clock::now();
+    vector<int> distances = deltaStepping(graph, 0, threads);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - t1).count();
+    cout << "  " << threads << " threads: " << seconds * 1000 << " ms, speedup vs Dijkstra "
+         << dijkstraSeconds / seconds << (distances == expected ? "" : " (MISMATCH)") << endl;
+  }
+}
+
+// Usage: ./delta_stepping bench [side] [delta]
+//   road graph: side x side grid, random graph: same vertex count, 4 edges each
+int main(int argc, char* argv[]){
+
+  if(argc > 1 && string(argv[1]) == "bench"){
+    int side = argc > 2 ? stoi(argv[2]) : 1000;
+    int delta = argc > 3 ? stoi(argv[3]) : 100;
+    if(delta < 1){
+      cout << "Delta must be at least 1, got " << delta << endl;
+      return 1;
+    }
+    int n = side * side;
+    speedupCurve("Road grid", n, buildGridEdges(side, 42), delta);
+    speedupCurve("Random graph", n, buildRandomEdges(n, 4 * n, 42), delta);
+    return 0;
+  }
+
+  // Graph structure (ids: A=0, B=1, C=2, D=3):
+  //   A --10--> B --15--> D
+  //    \                 /
+  //     5----> C --20---
+  vector<string> names = {"A", "B", "C", "D"};
+  SplitCsrGraph graph(4, {{0, 1, 10}, {0, 2, 5}, {1, 3, 15}, {2, 3, 20}}, 8);
+  vector<int> distances = deltaStepping(graph, 0, 2);
+  for(int v = 0; v < graph.vertexCount(); v++){
+    cout << "Distance A to " << names[v] << ": " << distances[v] << endl;
+  }
+
+  return 0;
+}
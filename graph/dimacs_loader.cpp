@@ -0,0 +1,652 @@
+#include<iostream>
+#include<fstream>
+#include<sstream>
+#include<vector>
+#include<string>
+#include<algorithm>
+#include<thread>
+#include<atomic>
+#include<cstdint>
+#include<cstdio>
+#include<chrono>
+#include<random>
+#include<fcntl.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<unistd.h>
+using namespace std;
+
+// Parallel loading of text graphs
+//
+// Supported inputs:
+//   - DIMACS shortest-path graphs (.gr): "c" comment lines, one
+//     "p sp <vertices> <arcs>" line, then "a <from> <to> <weight>" lines
+//     with 1-based vertex ids
+//   - DIMACS coordinates (.co): "p aux sp co <vertices>", then
+//     "v <id> <x> <y>" lines
+//   - CSV edge lists: "from,to,weight" per line with 0-based ids and an
+//     optional header line; the vertex count is the largest id + 1
+//
+// The file is mapped with mmap and cut into one chunk per thread, each
+// boundary moved forward to just after a newline, so every line belongs to
+// exactly one chunk. Threads parse their chunk with a hand-written integer
+// scanner (no iostreams, no allocation per line). The CSR arrays are then
+// built by a parallel counting sort: atomic per-vertex degree counts, a
+// prefix sum over vertex blocks, and an atomic-cursor scatter. A final
+// per-vertex sort by target makes the result independent of thread timing.
+
+// A single directed, weighted edge between two vertex ids
+struct Edge{
+  int from;
+  int to;
+  int weight;
+};
+
+// CSR graph (same layout as CsrGraph in map_navigation.cpp)
+struct LoadedGraph{
+  vector<int> offsets;   // Size V + 1
+  vector<int> targets;   // Size E
+  vector<int> weights;   // Size E
+  vector<int> x;         // Coordinates from a .co file, empty if none
+  vector<int> y;
+
+  int vertexCount() const{
+    return offsets.empty() ? 0 : (int)offsets.size() - 1;
+  }
+};
+
+// Read-only mapping of a whole file (as in MappedGraph in graph_file.cpp)
+class MappedFile{
+  public:
+    MappedFile() : data(nullptr), length(0){}
+
+    ~MappedFile(){
+      if(data != nullptr){
+        munmap((void*)data, length);
+      }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const string& path, string& error){
+      int fd = ::open(path.c_str(), O_RDONLY);
+      if(fd < 0){
+        error = "cannot open " + path;
+        return false;
+      }
+      struct stat info;
+      if(fstat(fd, &info) != 0){
+        ::close(fd);
+        error = "cannot stat " + path;
+        return false;
+      }
+      length = info.st_size;
+      if(length == 0){
+        ::close(fd);
+        return true;  // Empty file: nothing to map
+      }
+      void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+      ::close(fd);
+      if(mapping == MAP_FAILED){
+        length = 0;
+        error = "mmap failed";
+        return false;
+      }
+      madvise(mapping, length, MADV_SEQUENTIAL);
+      data = (const char*)mapping;
+      return true;
+    }
+
+    const char* begin() const{
+      return data;
+    }
+
+    const char* end() const{
+      return data + length;
+    }
+
+  private:
+    const char* data;
+    size_t length;
+};
+
+// Runs body(thread) on threadCount threads and waits for all of them
+template<typename Body>
+static void runThreads(int threadCount, const Body& body){
+  vector<std::thread> threads;
+  for(int t = 1; t < threadCount; t++){
+    threads.push_back(std::thread(body, t));
+  }
+  body(0);
+  for(std::thread& t : threads){
+    t.join();
+  }
+}
+
+// Hand-written scanner over [p, end); every function leaves p after what it read
+static inline void skipBlanks(const char*& p, const char* end){
+  while(p < end && (*p == ' ' || *p == '\t' || *p == '\r')){
+    p++;
+  }
+}
+
+static inline void skipLine(const char*& p, const char* end){
+  while(p < end && *p != '\n'){
+    p++;
+  }
+  if(p < end){
+    p++;
+  }
+}
+
+// Reads a non-negative decimal integer; false if there is none or it
+// exceeds INT_MAX
+static inline bool readInt(const char*& p, const char* end, int& value){
+  skipBlanks(p, end);
+  if(p == end || (unsigned)(*p - '0') > 9){
+    return false;
+  }
+  uint64_t result = 0;
+  while(p < end && (unsigned)(*p - '0') <= 9){
+    result = result * 10 + (*p - '0');
+    if(result > 0x7fffffff){
+      return false;
+    }
+    p++;
+  }
+  value = (int)result;
+  return true;
+}
+
+// True if the rest of the line is blank
+static inline bool atLineEnd(const char*& p, const char* end){
+  skipBlanks(p, end);
+  return p == end || *p == '\n';
+}
+
+// True if the line at p is a comment or blank; p is not moved
+static inline bool isHeaderFiller(const char* p, const char* end){
+  return *p == 'c' || atLineEnd(p, end);
+}
+
+// Chunk boundaries for threadCount threads over [begin, end): every
+// boundary but the first sits just after a newline (chunks may be empty)
+static vector<const char*> splitLines(const char* begin, const char* end, int threadCount){
+  vector<const char*> cuts(threadCount + 1, end);
+  cuts[0] = begin;
+  size_t length = end - begin;
+  for(int t = 1; t < threadCount; t++){
+    // p == begin (fewer bytes than threads) must move on: begin is already
+    // cut 0, and p[-1] would read before the mapping
+    const char* p = max(cuts[t - 1], begin + length / threadCount * t);
+    while(p < end && (p == begin || p[-1] != '\n')){
+      p++;
+    }
+    cuts[t] = p;
+  }
+  return cuts;
+}
+
+// Builds the CSR arrays from per-thread edge lists with a parallel counting
+// sort; the caller ensures the edge count fits the int offsets
+static void buildCsr(int vertexCount, const vector<vector<Edge> >& parts, int threadCount, LoadedGraph& graph){
+  vector<atomic<int> > degree(vertexCount);
+  runThreads(threadCount, [&](int t){
+    for(int v = t; v < vertexCount; v += threadCount){
+      degree[v].store(0, memory_order_relaxed);
+    }
+  });
+  runThreads(threadCount, [&](int t){
+    for(const Edge& edge : parts[t]){
+      degree[edge.from].fetch_add(1, memory_order_relaxed);
+    }
+  });
+
+  // Prefix sum: each thread sums its vertex block, block totals are scanned
+  // serially, then each thread writes its block's offsets
+  graph.offsets.assign(vertexCount + 1, 0);
+  vector<long long> blockTotal(threadCount + 1, 0);
+  auto blockBegin = [&](int t){ return (int)((long long)vertexCount * t / threadCount); };
+  runThreads(threadCount, [&](int t){
+    long long sum = 0;
+    for(int v = blockBegin(t); v < blockBegin(t + 1); v++){
+      sum += degree[v].load(memory_order_relaxed);
+    }
+    blockTotal[t + 1] = sum;
+  });
+  for(int t = 0; t < threadCount; t++){
+    blockTotal[t + 1] += blockTotal[t];
+  }
+  runThreads(threadCount, [&](int t){
+    long long running = blockTotal[t];
+    for(int v = blockBegin(t); v < blockBegin(t + 1); v++){
+      graph.offsets[v] = (int)running;
+      running += degree[v].load(memory_order_relaxed);
+      degree[v].store(graph.offsets[v], memory_order_relaxed);  // Becomes the scatter cursor
+    }
+  });
+  graph.offsets[vertexCount] = (int)blockTotal[threadCount];
+
+  // Scatter, then sort every adjacency range so the order is deterministic
+  graph.targets.resize(blockTotal[threadCount]);
+  graph.weights.resize(blockTotal[threadCount]);
+  runThreads(threadCount, [&](int t){
+    for(const Edge& edge : parts[t]){
+      int slot = degree[edge.from].fetch_add(1, memory_order_relaxed);
+      graph.targets[slot] = edge.to;
+      graph.weights[slot] = edge.weight;
+    }
+  });
+  runThreads(threadCount, [&](int t){
+    vector<pair<int, int> > adjacency;
+    for(int v = blockBegin(t); v < blockBegin(t + 1); v++){
+      int first = graph.offsets[v], last = graph.offsets[v + 1];
+      if(last - first < 2){
+        continue;
+      }
+      adjacency.clear();
+      for(int e = first; e < last; e++){
+        adjacency.push_back(make_pair(graph.targets[e], graph.weights[e]));
+      }
+      sort(adjacency.begin(), adjacency.end());
+      for(int e = first; e < last; e++){
+        graph.targets[e] = adjacency[e - first].first;
+        graph.weights[e] = adjacency[e - first].second;
+      }
+    }
+  });
+}
+
+// Loads a DIMACS .gr file. Returns false with a reason in error if the
+// file is missing or malformed (bad line, id out of range, arc count that
+// does not match the "p" line)
+bool loadDimacsGraph(const string& path, int threadCount, LoadedGraph& graph, string& error){
+  threadCount = max(1, threadCount);
+  MappedFile file;
+  if(!file.open(path, error)){
+    return false;
+  }
+  const char* p = file.begin();
+  const char* end = file.end();
+
+  // The problem line comes before the first arc; read the header serially.
+  // It may only hold comments, blank lines and exactly one problem line
+  int vertexCount = -1, arcCount = -1;
+  while(p < end && *p != 'a'){
+    if(*p == 'p'){
+      if(vertexCount >= 0){
+        error = "second problem line at byte " + to_string(p - file.begin());
+        return false;
+      }
+      const char* q = p + 1;
+      skipBlanks(q, end);
+      if(end - q < 2 || q[0] != 's' || q[1] != 'p'){
+        error = "expected \"p sp <vertices> <arcs>\"";
+        return false;
+      }
+      q += 2;
+      if(!readInt(q, end, vertexCount) || !readInt(q, end, arcCount) || !atLineEnd(q, end)){
+        error = "malformed problem line";
+        return false;
+      }
+    }
+    else if(!isHeaderFiller(p, end)){
+      error = "unexpected line at byte " + to_string(p - file.begin());
+      return false;
+    }
+    skipLine(p, end);
+  }
+  if(vertexCount < 0){
+    error = "missing problem line";
+    return false;
+  }
+
+  vector<const char*> cuts = splitLines(p, end, threadCount);
+  vector<vector<Edge> > parts(threadCount);
+  vector<string> errors(threadCount);
+  runThreads(threadCount, [&](int t){
+    const char* q = cuts[t];
+    const char* stop = cuts[t + 1];
+    vector<Edge>& edges = parts[t];
+    edges.reserve((stop - q) / 16);
+    while(q < stop){
+      const char* line = q;
+      if(*q == 'a'){
+        q++;
+        Edge edge;
+        if(!readInt(q, stop, edge.from) || !readInt(q, stop, edge.to) || !readInt(q, stop, edge.weight)
+           || !atLineEnd(q, stop) || edge.from < 1 || edge.from > vertexCount || edge.to < 1 || edge.to > vertexCount){
+          errors[t] = "bad arc line at byte " + to_string(line - file.begin());
+          return;
+        }
+        edge.from--;
+        edge.to--;
+        edges.push_back(edge);
+      }
+      else if(*q != 'c' && *q != '\n' && !atLineEnd(q, stop)){
+        errors[t] = "unexpected line at byte " + to_string(line - file.begin());
+        return;
+      }
+      skipLine(q, stop);
+    }
+  });
+  size_t loadedArcs = 0;
+  for(int t = 0; t < threadCount; t++){
+    if(!errors[t].empty()){
+      error = errors[t];
+      return false;
+    }
+    loadedArcs += parts[t].size();
+  }
+  if(loadedArcs != (size_t)arcCount){
+    error = "problem line announces " + to_string(arcCount) + " arcs, file has " + to_string(loadedArcs);
+    return false;
+  }
+
+  buildCsr(vertexCount, parts, threadCount, graph);
+  return true;
+}
+
+// Loads a DIMACS .co file into graph.x and graph.y; the vertex count must
+// match the already loaded graph
+bool loadDimacsCoordinates(const string& path, int threadCount, LoadedGraph& graph, string& error){
+  threadCount = max(1, threadCount);
+  MappedFile file;
+  if(!file.open(path, error)){
+    return false;
+  }
+  const char* p = file.begin();
+  const char* end = file.end();
+  int vertexCount = -1;
+  while(p < end && *p != 'v'){
+    if(*p == 'p'){
+      if(vertexCount >= 0){
+        error = "second problem line at byte " + to_string(p - file.begin());
+        return false;
+      }
+      const char* q = p + 1;
+      string words[3] = {"aux", "sp", "co"};
+      bool ok = true;
+      for(const string& word : words){
+        skipBlanks(q, end);
+        ok = ok && end - q >= (long)word.size() && string(q, word.size()) == word;
+        q += ok ? word.size() : 0;
+      }
+      if(!ok || !readInt(q, end, vertexCount) || !atLineEnd(q, end)){
+        error = "expected \"p aux sp co <vertices>\"";
+        return false;
+      }
+    }
+    else if(!isHeaderFiller(p, end)){
+      error = "unexpected line at byte " + to_string(p - file.begin());
+      return false;
+    }
+    skipLine(p, end);
+  }
+  if(vertexCount != graph.vertexCount()){
+    error = "coordinate file does not match the graph's vertex count";
+    return false;
+  }
+
+  graph.x.assign(vertexCount, 0);
+  graph.y.assign(vertexCount, 0);
+  vector<const char*> cuts = splitLines(p, end, threadCount);
+  vector<string> errors(threadCount);
+  runThreads(threadCount, [&](int t){
+    const char* q = cuts[t];
+    const char* stop = cuts[t + 1];
+    while(q < stop){
+      const char* line = q;
+      if(*q == 'v'){
+        q++;
+        int id, x, y;
+        // Coordinates may be negative (western/southern hemispheres)
+        skipBlanks(q, stop);
+        bool ok = readInt(q, stop, id) && id >= 1 && id <= vertexCount;
+        int sign[2] = {1, 1};
+        int* values[2] = {&x, &y};
+        for(int i = 0; i < 2 && ok; i++){
+          skipBlanks(q, stop);
+          if(q < stop && *q == '-'){
+            sign[i] = -1;
+            q++;
+          }
+          ok = readInt(q, stop, *values[i]);
+        }
+        if(!ok || !atLineEnd(q, stop)){
+          errors[t] = "bad coordinate line at byte " + to_string(line - file.begin());
+          return;
+        }
+        graph.x[id - 1] = sign[0] * x;
+        graph.y[id - 1] = sign[1] * y;
+      }
+      else if(*q != 'c' && *q != '\n' && !atLineEnd(q, stop)){
+        errors[t] = "unexpected line at byte " + to_string(line - file.begin());
+        return;
+      }
+      skipLine(q, stop);
+    }
+  });
+  for(const string& message : errors){
+    if(!message.empty()){
+      error = message;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Loads a "from,to,weight" CSV edge list with 0-based ids. A first line
+// that does not start with a digit is taken as a header and skipped
+bool loadCsvEdges(const string& path, int threadCount, LoadedGraph& graph, string& error){
+  threadCount = max(1, threadCount);
+  MappedFile file;
+  if(!file.open(path, error)){
+    return false;
+  }
+  const char* p = file.begin();
+  const char* end = file.end();
+  if(p < end && (unsigned)(*p - '0') > 9){
+    skipLine(p, end);
+  }
+
+  vector<const char*> cuts = splitLines(p, end, threadCount);
+  vector<vector<Edge> > parts(threadCount);
+  vector<string> errors(threadCount);
+  vector<int> largestId(threadCount, -1);
+  runThreads(threadCount, [&](int t){
+    const char* q = cuts[t];
+    const char* stop = cuts[t + 1];
+    vector<Edge>& edges = parts[t];
+    edges.reserve((stop - q) / 12);
+    while(q < stop){
+      const char* line = q;
+      if(atLineEnd(q, stop)){
+        skipLine(q, stop);
+        continue;
+      }
+      Edge edge;
+      bool ok = readInt(q, stop, edge.from);
+      skipBlanks(q, stop);
+      ok = ok && q < stop && *q++ == ',' && readInt(q, stop, edge.to);
+      skipBlanks(q, stop);
+      ok = ok && q < stop && *q++ == ',' && readInt(q, stop, edge.weight) && atLineEnd(q, stop);
+      if(!ok){
+        errors[t] = "bad CSV line at byte " + to_string(line - file.begin());
+        return;
+      }
+      largestId[t] = max(largestId[t], max(edge.from, edge.to));
+      edges.push_back(edge);
+      skipLine(q, stop);
+    }
+  });
+  int vertexCount = 0;
+  size_t loadedEdges = 0;
+  for(int t = 0; t < threadCount; t++){
+    if(!errors[t].empty()){
+      error = errors[t];
+      return false;
+    }
+    vertexCount = max(vertexCount, largestId[t] + 1);
+    loadedEdges += parts[t].size();
+  }
+  if(loadedEdges > 0x7fffffff){
+    error = "more edges than 32-bit CSR offsets can address";
+    return false;
+  }
+
+  buildCsr(vertexCount, parts, threadCount, graph);
+  return true;
+}
+
+// iostream reference loader for .gr files, for the speed comparison
+LoadedGraph loadDimacsWithStreams(const string& path){
+  ifstream in(path);
+  string line;
+  int vertexCount = 0;
+  vector<Edge> edges;
+  while(getline(in, line)){
+    if(line.empty() || line[0] == 'c'){
+      continue;
+    }
+    istringstream fields(line);
+    string kind;
+    fields >> kind;
+    if(kind == "p"){
+      string problem;
+      int arcs;
+      fields >> problem >> vertexCount >> arcs;
+    }
+    else if(kind == "a"){
+      Edge edge;
+      fields >> edge.from >> edge.to >> edge.weight;
+      edges.push_back({edge.from - 1, edge.to - 1, edge.weight});
+    }
+  }
+  LoadedGraph graph;
+  vector<vector<Edge> > parts(1, edges);
+  buildCsr(vertexCount, parts, 1, graph);
+  return graph;
+}
+
+// Writes a side x side grid with random weights in [1, 100] as a .gr file,
+// arcs grouped by source as in the DIMACS challenge files or, with shuffle,
+// in random order as in some edge-list exports
+void writeGridDimacs(const string& path, int side, bool shuffle, unsigned seed){
+  mt19937 rng(seed);
+  uniform_int_distribution<int> weight(1, 100);
+  vector<Edge> edges;
+  for(int row = 0; row < side; row++){
+    for(int col = 0; col < side; col++){
+      int here = row * side + col;
+      if(col + 1 < side){
+        int w = weight(rng);
+        edges.push_back({here, here + 1, w});
+        edges.push_back({here + 1, here, w});
+      }
+      if(row + 1 < side){
+        int w = weight(rng);
+        edges.push_back({here, here + side, w});
+        edges.push_back({here + side, here, w});
+      }
+    }
+  }
+  if(shuffle){
+    std::shuffle(edges.begin(), edges.end(), rng);
+  }
+  else{
+    stable_sort(edges.begin(), edges.end(), [](const Edge& a, const Edge& b){ return a.from < b.from; });
+  }
+  FILE* out = fopen(path.c_str(), "w");
+  if(out == nullptr){
+    return;
+  }
+  fprintf(out, "c %dx%d grid\np sp %d %zu\n", side, side, side * side, edges.size());
+  for(const Edge& edge : edges){
+    fprintf(out, "a %d %d %d\n", edge.from + 1, edge.to + 1, edge.weight);
+  }
+  fclose(out);
+}
+
+// Writes a grid .gr file and times the iostream loader against the parallel
+// one for 1, 2, 4, ... threads up to the core count. Shuffled arcs make the
+// CSR scatter a random write per arc, which shows up as lower throughput
+// once the arrays outgrow the cache
+void runBenchmark(const string& label, int side, bool shuffle){
+  string path = "dimacs_bench.gr";
+  writeGridDimacs(path, side, shuffle, 42);
+  struct stat info;
+  stat(path.c_str(), &info);
+  double megabytes = info.st_size / 1e6;
+
+  auto t0 = chrono::steady_clock::now();
+  LoadedGraph expected = loadDimacsWithStreams(path);
+  double streamSeconds = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+  cout << label << ": " << megabytes << " MB, " << expected.vertexCount() << " vertices, "
+       << expected.targets.size() << " arcs" << endl;
+  cout << "  iostreams: " << streamSeconds * 1000 << " ms, " << megabytes / streamSeconds << " MB/s" << endl;
+
+  int cores = max(1, (int)thread::hardware_concurrency());
+  for(int threads = 1; ; threads = min(threads * 2, cores)){
+    LoadedGraph graph;
+    string error;
+    auto t1 = chrono::steady_clock::now();
+    bool ok = loadDimacsGraph(path, threads, graph, error);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - t1).count();
+    bool same = ok && graph.offsets == expected.offsets && graph.targets == expected.targets
+                && graph.weights == expected.weights;
+    cout << "  " << threads << " threads: " << seconds * 1000 << " ms, " << megabytes / seconds << " MB/s"
+         << (same ? "" : " (MISMATCH " + error + ")") << endl;
+    if(threads == cores){
+      break;
+    }
+  }
+  remove(path.c_str());
+}
+
+// Main function: loads the small example map from each supported format
+// Usage: ./dimacs_loader bench [side]
+int main(int argc, char* argv[]){
+
+  if(argc > 1 && string(argv[1]) == "bench"){
+    int side = argc > 2 ? stoi(argv[2]) : 1000;
+    runBenchmark("Grid, arcs by source", side, false);
+    runBenchmark("Grid, shuffled arcs", side, true);
+    return 0;
+  }
+
+  // Graph structure (ids: A=1, B=2, C=3, D=4 in DIMACS, 0-3 in CSV):
+  //   A --10--> B --15--> D
+  //    \                 /
+  //     5----> C --20---
+  vector<string> names = {"A", "B", "C", "D"};
+  {
+    ofstream gr("example.gr"), co("example.co"), csv("example.csv");
+    gr << "c example map\np sp 4 4\na 1 2 10\na 1 3 5\na 2 4 15\na 3 4 20\n";
+    co << "p aux sp co 4\nv 1 13400 52520\nv 2 13450 52510\nv 3 13380 52500\nv 4 -13470 52490\n";
+    csv << "from,to,weight\n0,1,10\n0,2,5\n1,3,15\n2,3,20\n";
+  }
+
+  LoadedGraph dimacs, csv;
+  string error;
+  if(!loadDimacsGraph("example.gr", 2, dimacs, error) || !loadDimacsCoordinates("example.co", 2, dimacs, error)
+     || !loadCsvEdges("example.csv", 2, csv, error)){
+    cout << "Load failed: " << error << endl;
+    return 1;
+  }
+  for(int v = 0; v < dimacs.vertexCount(); v++){
+    cout << names[v] << " (" << dimacs.x[v] << ", " << dimacs.y[v] << "):";
+    for(int e = dimacs.offsets[v]; e < dimacs.offsets[v + 1]; e++){
+      cout << " -> " << names[dimacs.targets[e]] << " (" << dimacs.weights[e] << ")";
+    }
+    cout << endl;
+  }
+  cout << "CSV load matches DIMACS: "
+       << (csv.offsets == dimacs.offsets && csv.targets == dimacs.targets && csv.weights == dimacs.weights ? "yes" : "no")
+       << endl;
+  remove("example.gr");
+  remove("example.co");
+  remove("example.csv");
+  return 0;
+}
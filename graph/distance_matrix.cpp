@@ -0,0 +1,367 @@
+#include<iostream>
+#include<vector>
+#include<string>
+#include<algorithm>
+#include<thread>
+#include<mutex>
+#include<condition_variable>
+#include<functional>
+#include<atomic>
+#include<climits>
+#include<chrono>
+#include<random>
+#include<iomanip>
+using namespace std;
+
+// Many-to-many travel-time matrices
+//
+// For N sources and M targets the matrix is filled by N one-to-many Dijkstra
+// searches instead of N x M point-to-point queries. Each search stops as soon
+// as every target is settled. The searches are independent, so they are
+// handed out to a fixed pool of worker threads, each reusing one workspace
+// for all the sources it processes.
+
+// A single directed, weighted edge between two vertex ids
+struct Edge{
+  int from;
+  int to;
+  int weight;
+};
+
+// Immutable CSR graph (same layout as CsrGraph in map_navigation.cpp)
+class CsrGraph{
+  public:
+    vector<int> offsets;   // Size V + 1: start of each vertex's edge range
+    vector<int> targets;   // Size E: head vertex of each edge
+    vector<int> weights;   // Size E: weight of each edge
+
+    CsrGraph(int vertexCount, const vector<Edge>& edges) : offsets(vertexCount + 1, 0){
+      for(const Edge& edge : edges){
+        offsets[edge.from + 1]++;
+      }
+      for(int v = 0; v < vertexCount; v++){
+        offsets[v + 1] += offsets[v];
+      }
+      targets.resize(edges.size());
+      weights.resize(edges.size());
+      vector<int> next(offsets.begin(), offsets.end() - 1);
+      for(const Edge& edge : edges){
+        int slot = next[edge.from]++;
+        targets[slot] = edge.to;
+        weights[slot] = edge.weight;
+      }
+    }
+
+    int vertexCount() const{
+      return (int)offsets.size() - 1;
+    }
+};
+
+// Reusable Dijkstra state with generation stamps (see QueryWorkspace in
+// map_navigation.cpp): reset() is O(1) and warm searches do not allocate
+class QueryWorkspace{
+  public:
+    typedef pair<int, int> HeapEntry;  // (distance, vertex)
+
+    explicit QueryWorkspace(int vertexCount)
+      : distances(vertexCount), stamps(vertexCount, 0), settledStamps(vertexCount, 0), generation(0){}
+
+    void reset(){
+      generation++;
+      if(generation == 0){
+        fill(stamps.begin(), stamps.end(), 0);
+        fill(settledStamps.begin(), settledStamps.end(), 0);
+        generation = 1;
+      }
+      heap.clear();
+    }
+
+    int distance(int vertex) const{
+      return stamps[vertex] == generation ? distances[vertex] : INT_MAX;
+    }
+
+    void update(int vertex, int distance){
+      distances[vertex] = distance;
+      stamps[vertex] = generation;
+    }
+
+    bool isSettled(int vertex) const{
+      return settledStamps[vertex] == generation;
+    }
+
+    void settle(int vertex){
+      settledStamps[vertex] = generation;
+    }
+
+    bool heapEmpty() const{
+      return heap.empty();
+    }
+
+    void push(int distance, int vertex){
+      heap.push_back(HeapEntry(distance, vertex));
+      push_heap(heap.begin(), heap.end(), greater<HeapEntry>());
+    }
+
+    HeapEntry pop(){
+      pop_heap(heap.begin(), heap.end(), greater<HeapEntry>());
+      HeapEntry top = heap.back();
+      heap.pop_back();
+      return top;
+    }
+
+  private:
+    vector<int> distances;
+    vector<unsigned> stamps;
+    vector<unsigned> settledStamps;
+    vector<HeapEntry> heap;
+    unsigned generation;
+};
+
+// Fixed set of worker threads that run one job at a time
+// run(job) calls job(workerIndex) once on every worker and waits for all
+// of them; the workers sleep between jobs instead of being re-created
+class WorkerPool{
+  public:
+    explicit WorkerPool(int threadCount) : jobGeneration(0), running(0), stopping(false){
+      for(int i = 0; i < threadCount; i++){
+        workers.push_back(thread(&WorkerPool::workerLoop, this, i));
+      }
+    }
+
+    ~WorkerPool(){
+      {
+        lock_guard<mutex> lock(m);
+        stopping = true;
+      }
+      wake.notify_all();
+      for(thread& worker : workers){
+        worker.join();
+      }
+    }
+
+    int size() const{
+      return (int)workers.size();
+    }
+
+    void run(const function<void(int)>& newJob){
+      unique_lock<mutex> lock(m);
+      job = newJob;
+      running = (int)workers.size();
+      jobGeneration++;
+      wake.notify_all();
+      done.wait(lock, [this](){ return running == 0; });
+      job = nullptr;
+    }
+
+  private:
+    vector<thread> workers;
+    mutex m;
+    condition_variable wake;
+    condition_variable done;
+    function<void(int)> job;
+    unsigned jobGeneration;
+    int running;
+    bool stopping;
+
+    void workerLoop(int index){
+      unsigned seen = 0;
+      for(;;){
+        function<void(int)> current;
+        {
+          unique_lock<mutex> lock(m);
+          wake.wait(lock, [this, seen](){ return stopping || jobGeneration != seen; });
+          if(stopping){
+            return;
+          }
+          seen = jobGeneration;
+          current = job;
+        }
+        current(index);
+        {
+          lock_guard<mutex> lock(m);
+          if(--running == 0){
+            done.notify_one();
+          }
+        }
+      }
+    }
+};
+
+// Computes N x M distance matrices on one graph
+// Owns a worker pool and one workspace per worker, so repeated calls reuse
+// both the threads and the distance arrays
+class DistanceMatrixEngine{
+  public:
+    DistanceMatrixEngine(const CsrGraph& graph, int threadCount)
+      : graph(graph), pool(max(1, threadCount)), targetCount(graph.vertexCount(), 0){
+      for(int i = 0; i < pool.size(); i++){
+        workspaces.push_back(QueryWorkspace(graph.vertexCount()));
+      }
+    }
+
+    // Returns the sources.size() x targets.size() matrix in row-major order:
+    // entry [i * targets.size() + j] is the distance from sources[i] to
+    // targets[j], INT_MAX if unreachable. Sources are handed out to workers
+    // one at a time through a shared counter, so uneven searches balance out
+    vector<int> compute(const vector<int>& sources, const vector<int>& targets){
+      size_t columns = targets.size();
+      vector<int> matrix(sources.size() * columns, INT_MAX);
+
+      // targetCount marks target vertices (a vertex may be listed twice)
+      int distinctTargets = 0;
+      for(int target : targets){
+        distinctTargets += targetCount[target]++ == 0;
+      }
+
+      atomic<size_t> nextSource(0);
+      pool.run([&](int worker){
+        QueryWorkspace& workspace = workspaces[worker];
+        for(size_t i = nextSource++; i < sources.size(); i = nextSource++){
+          searchToTargets(sources[i], distinctTargets, workspace);
+          int* row = &matrix[i * columns];
+          for(size_t j = 0; j < columns; j++){
+            row[j] = workspace.distance(targets[j]);
+          }
+        }
+      });
+
+      for(int target : targets){
+        targetCount[target] = 0;
+      }
+      return matrix;
+    }
+
+  private:
+    const CsrGraph& graph;
+    WorkerPool pool;
+    vector<QueryWorkspace> workspaces;
+    vector<int> targetCount;  // Read-only while workers run
+
+    // One-to-many Dijkstra that stops once all distinct targets are settled
+    void searchToTargets(int source, int distinctTargets, QueryWorkspace& workspace) const{
+      workspace.reset();
+      workspace.update(source, 0);
+      workspace.push(0, source);
+      int remaining = distinctTargets;
+
+      while(!workspace.heapEmpty() && remaining > 0){
+        QueryWorkspace::HeapEntry top = workspace.pop();
+        int current = top.second;
+        if(workspace.isSettled(current)){
+          continue;
+        }
+        workspace.settle(current);
+        remaining -= targetCount[current] > 0;
+
+        for(int e = graph.offsets[current]; e < graph.offsets[current + 1]; e++){
+          int neighbor = graph.targets[e];
+          int newDistance = top.first + graph.weights[e];
+          if(!workspace.isSettled(neighbor) && newDistance < workspace.distance(neighbor)){
+            workspace.update(neighbor, newDistance);
+            workspace.push(newDistance, neighbor);
+          }
+        }
+      }
+    }
+};
+
+// Road-like side x side grid with random weights in [1, 100] in both directions
+vector<Edge> buildGridEdges(int side, unsigned seed){
+  mt19937 rng(seed);
+  uniform_int_distribution<int> weight(1, 100);
+  vector<Edge> edges;
+  for(int row = 0; row < side; row++){
+    for(int col = 0; col < side; col++){
+      int here = row * side + col;
+      if(col + 1 < side){
+        int w = weight(rng);
+        edges.push_back({here, here + 1, w});
+        edges.push_back({here + 1, here, w});
+      }
+      if(row + 1 < side){
+        int w = weight(rng);
+        edges.push_back({here, here + side, w});
+        edges.push_back({here + side, here, w});
+      }
+    }
+  }
+  return edges;
+}
+
+// Times an N x N matrix on a grid graph for 1, 2, 4, ... threads up to the
+// core count and checks every run against the single-threaded matrix
+// Usage: ./distance_matrix bench [side] [N]
+void runBenchmark(int side, int count){
+  CsrGraph graph(side * side, buildGridEdges(side, 42));
+  mt19937 rng(7);
+  vector<int> sources(count), targets(count);
+  for(int i = 0; i < count; i++){
+    sources[i] = rng() % graph.vertexCount();
+    targets[i] = rng() % graph.vertexCount();
+  }
+
+  // Thread counts 1, 2, 4, ... plus the core count itself
+  int cores = max(1, (int)thread::hardware_concurrency());
+  vector<int> threadCounts;
+  for(int threads = 1; threads < cores; threads *= 2){
+    threadCounts.push_back(threads);
+  }
+  threadCounts.push_back(cores);
+
+  vector<int> expected;
+  double singleThreaded = 0;
+  cout << "Grid " << side << "x" << side << ", " << count << "x" << count << " matrix" << endl;
+  for(int threads : threadCounts){
+    DistanceMatrixEngine engine(graph, threads);
+    engine.compute(sources, targets);  // Warm-up: workspaces touched once
+    auto t0 = chrono::steady_clock::now();
+    vector<int> matrix = engine.compute(sources, targets);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    if(threads == 1){
+      expected = matrix;
+      singleThreaded = seconds;
+    }
+    cout << "  " << threads << " threads: " << seconds * 1000 << " ms, speedup "
+         << singleThreaded / seconds << (matrix == expected ? "" : " (MISMATCH)") << endl;
+  }
+}
+
+// Main function: travel-time matrix on a small example map
+int main(int argc, char* argv[]){
+
+  if(argc > 1 && string(argv[1]) == "bench"){
+    int side = argc > 2 ? stoi(argv[2]) : 300;
+    int count = argc > 3 ? stoi(argv[3]) : 200;
+    runBenchmark(side, count);
+    return 0;
+  }
+
+  // Graph structure (ids: A=0, B=1, C=2, D=3):
+  //   A --10--> B --15--> D
+  //    \                 /
+  //     5----> C --20---
+  vector<string> names = {"A", "B", "C", "D"};
+  CsrGraph graph(4, {{0, 1, 10}, {0, 2, 5}, {1, 3, 15}, {2, 3, 20}});
+
+  // Depots A and B to customers C and D
+  vector<int> sources = {0, 1};
+  vector<int> targets = {2, 3};
+  DistanceMatrixEngine engine(graph, 2);
+  vector<int> matrix = engine.compute(sources, targets);
+
+  cout << "  ";
+  for(int target : targets){
+    cout << setw(6) << names[target];
+  }
+  cout << endl;
+  for(size_t i = 0; i < sources.size(); i++){
+    cout << names[sources[i]] << " ";
+    for(size_t j = 0; j < targets.size(); j++){
+      int distance = matrix[i * targets.size() + j];
+      cout << setw(6) << (distance == INT_MAX ? string("-") : to_string(distance));
+    }
+    cout << endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,362 @@
+#include<iostream>
+#include<vector>
+#include<string>
+#include<algorithm>
+#include<queue>
+#include<climits>
+#include<chrono>
+#include<random>
+using namespace std;
+
+// Shortest-path tree that is repaired in place when edge weights change
+//
+// Traffic only changes weights, never the road network itself, so the graph
+// keeps a fixed CSR topology with a mutable weight per edge. The tree from a
+// fixed source is stored as a distance and a parent edge per vertex.
+//
+// A batch of weight changes is applied in one repair pass, in the spirit of
+// Ramalingam and Reps:
+//   1. Increased tree edges: the subtree below each one may get longer, so
+//      those vertices are "affected" and their distances are forgotten.
+//      Every other vertex keeps a valid upper bound, because its tree path
+//      does not use an increased edge.
+//   2. Each affected vertex gets its best candidate distance through an
+//      in-edge from an unaffected vertex.
+//   3. Every decreased edge that now gives its head a shorter distance
+//      lowers that head.
+//   4. A Dijkstra pass seeded with only the vertices from steps 2 and 3
+//      spreads the changes. It settles nothing outside the region whose
+//      distance or parent actually changes.
+// So the cost depends on the size of that region, not on the graph.
+
+// A single directed, weighted edge between two vertex ids
+struct Edge{
+  int from;
+  int to;
+  int weight;
+};
+
+// New weight for the edge with the given id
+struct WeightUpdate{
+  int edge;
+  int weight;
+};
+
+class DynamicShortestPaths{
+  public:
+    // Builds the forward and reverse CSR arrays and computes the initial tree
+    // Edge ids are positions in the edges vector, and stay stable
+    DynamicShortestPaths(int vertexCount, const vector<Edge>& edges, int source)
+      : source(source), edgeFrom(edges.size()), edgeTo(edges.size()), weights(edges.size()),
+        outOffsets(vertexCount + 1, 0), outEdges(edges.size()), inOffsets(vertexCount + 1, 0), inEdges(edges.size()),
+        distances(vertexCount, INT_MAX), parentEdge(vertexCount, -1), affectedStamp(vertexCount, 0), stamp(0){
+      for(size_t e = 0; e < edges.size(); e++){
+        edgeFrom[e] = edges[e].from;
+        edgeTo[e] = edges[e].to;
+        weights[e] = edges[e].weight;
+        outOffsets[edges[e].from + 1]++;
+        inOffsets[edges[e].to + 1]++;
+      }
+      for(int v = 0; v < vertexCount; v++){
+        outOffsets[v + 1] += outOffsets[v];
+        inOffsets[v + 1] += inOffsets[v];
+      }
+      vector<int> nextOut(outOffsets.begin(), outOffsets.end() - 1);
+      vector<int> nextIn(inOffsets.begin(), inOffsets.end() - 1);
+      for(size_t e = 0; e < edges.size(); e++){
+        outEdges[nextOut[edges[e].from]++] = (int)e;
+        inEdges[nextIn[edges[e].to]++] = (int)e;
+      }
+
+      distances[source] = 0;
+      push(0, source);
+      propagate();
+    }
+
+    int vertexCount() const{
+      return (int)distances.size();
+    }
+
+    // Current shortest distance from the source, INT_MAX if unreachable
+    int distance(int vertex) const{
+      return distances[vertex];
+    }
+
+    // Id of the tree edge into vertex, -1 for the source and unreachable vertices
+    int parent(int vertex) const{
+      return parentEdge[vertex];
+    }
+
+    // Id of an edge from -> to, -1 if there is none
+    int findEdge(int from, int to) const{
+      for(int i = outOffsets[from]; i < outOffsets[from + 1]; i++){
+        if(edgeTo[outEdges[i]] == to){
+          return outEdges[i];
+        }
+      }
+      return -1;
+    }
+
+    int weight(int edge) const{
+      return weights[edge];
+    }
+
+    int edgeSource(int edge) const{
+      return edgeFrom[edge];
+    }
+
+    // Applies a batch of weight changes and repairs the tree in one pass
+    // Later updates of the same edge win
+    // Returns: number of vertices whose distance was recomputed or lowered
+    int applyUpdates(const vector<WeightUpdate>& updates){
+      stamp++;
+      touched = 0;
+
+      // Step 1: apply the weights, then collect the roots of affected subtrees
+      vector<int> increasedTreeEdges;
+      vector<int> decreasedEdges;
+      for(const WeightUpdate& update : updates){
+        int old = weights[update.edge];
+        weights[update.edge] = update.weight;
+        if(update.weight > old && parentEdge[edgeTo[update.edge]] == update.edge){
+          increasedTreeEdges.push_back(update.edge);
+        }
+        else if(update.weight < old){
+          decreasedEdges.push_back(update.edge);
+        }
+      }
+
+      // Walk each subtree down the tree. A child of u is a target x of an
+      // out-edge e of u with parentEdge[x] == e
+      vector<int>& affected = scratch;
+      affected.clear();
+      for(int e : increasedTreeEdges){
+        int root = edgeTo[e];
+        if(parentEdge[root] != e || affectedStamp[root] == stamp){
+          continue;  // Edge listed twice, or already inside another subtree
+        }
+        size_t first = affected.size();
+        affectedStamp[root] = stamp;
+        affected.push_back(root);
+        for(size_t i = first; i < affected.size(); i++){
+          int u = affected[i];
+          for(int j = outOffsets[u]; j < outOffsets[u + 1]; j++){
+            int child = edgeTo[outEdges[j]];
+            if(parentEdge[child] == outEdges[j] && affectedStamp[child] != stamp){
+              affectedStamp[child] = stamp;
+              affected.push_back(child);
+            }
+          }
+        }
+      }
+      for(int v : affected){
+        distances[v] = INT_MAX;
+        parentEdge[v] = -1;
+      }
+
+      // Step 2: best entry into each affected vertex from outside the region
+      for(int v : affected){
+        for(int i = inOffsets[v]; i < inOffsets[v + 1]; i++){
+          int e = inEdges[i];
+          int u = edgeFrom[e];
+          if(affectedStamp[u] != stamp && distances[u] != INT_MAX && distances[u] + weights[e] < distances[v]){
+            distances[v] = distances[u] + weights[e];
+            parentEdge[v] = e;
+          }
+        }
+        if(distances[v] != INT_MAX){
+          push(distances[v], v);
+        }
+      }
+
+      // Step 3: decreased edges that shorten their head
+      for(int e : decreasedEdges){
+        int u = edgeFrom[e], v = edgeTo[e];
+        if(distances[u] != INT_MAX && distances[u] + weights[e] < distances[v]){
+          distances[v] = distances[u] + weights[e];
+          parentEdge[v] = e;
+          push(distances[v], v);
+        }
+      }
+
+      // Step 4: spread the changes
+      propagate();
+      return touched;
+    }
+
+  private:
+    typedef pair<int, int> HeapEntry;  // (distance, vertex)
+
+    int source;
+    vector<int> edgeFrom, edgeTo, weights;
+    vector<int> outOffsets, outEdges;  // Out-edge ids of each vertex
+    vector<int> inOffsets, inEdges;    // In-edge ids of each vertex
+    vector<int> distances;
+    vector<int> parentEdge;
+    vector<unsigned> affectedStamp;    // == stamp while inside an affected subtree
+    unsigned stamp;
+    vector<HeapEntry> heap;            // Reused across repairs
+    vector<int> scratch;
+    int touched;
+
+    void push(int distance, int vertex){
+      heap.push_back(HeapEntry(distance, vertex));
+      push_heap(heap.begin(), heap.end(), greater<HeapEntry>());
+    }
+
+    // Dijkstra from whatever is in the heap; every vertex holds an upper bound
+    void propagate(){
+      while(!heap.empty()){
+        pop_heap(heap.begin(), heap.end(), greater<HeapEntry>());
+        HeapEntry top = heap.back();
+        heap.pop_back();
+        int u = top.second;
+        if(top.first > distances[u]){
+          continue;
+        }
+        touched++;
+        for(int i = outOffsets[u]; i < outOffsets[u + 1]; i++){
+          int e = outEdges[i];
+          int v = edgeTo[e];
+          int newDistance = top.first + weights[e];
+          if(newDistance < distances[v]){
+            distances[v] = newDistance;
+            parentEdge[v] = e;
+            push(newDistance, v);
+          }
+        }
+      }
+    }
+};
+
+// Full recomputation used as the reference in runBenchmark()
+vector<int> recomputeDistances(int vertexCount, const vector<Edge>& edges, int source){
+  vector<vector<pair<int, int> > > adjacency(vertexCount);
+  for(const Edge& edge : edges){
+    adjacency[edge.from].push_back(make_pair(edge.to, edge.weight));
+  }
+  vector<int> distances(vertexCount, INT_MAX);
+  priority_queue<pair<int, int>, vector<pair<int, int> >, greater<pair<int, int> > > frontier;
+  distances[source] = 0;
+  frontier.push(make_pair(0, source));
+  while(!frontier.empty()){
+    pair<int, int> top = frontier.top();
+    frontier.pop();
+    if(top.first > distances[top.second]){
+      continue;
+    }
+    for(const pair<int, int>& next : adjacency[top.second]){
+      if(top.first + next.second < distances[next.first]){
+        distances[next.first] = top.first + next.second;
+        frontier.push(make_pair(distances[next.first], next.first));
+      }
+    }
+  }
+  return distances;
+}
+
+// Road-like side x side grid with random weights in [1, 100] in both directions
+vector<Edge> buildGridEdges(int side, unsigned seed){
+  mt19937 rng(seed);
+  uniform_int_distribution<int> weight(1, 100);
+  vector<Edge> edges;
+  for(int row = 0; row < side; row++){
+    for(int col = 0; col < side; col++){
+      int here = row * side + col;
+      if(col + 1 < side){
+        int w = weight(rng);
+        edges.push_back({here, here + 1, w});
+        edges.push_back({here + 1, here, w});
+      }
+      if(row + 1 < side){
+        int w = weight(rng);
+        edges.push_back({here, here + side, w});
+        edges.push_back({here + side, here, w});
+      }
+    }
+  }
+  return edges;
+}
+
+// Applies batches of random weight changes and compares the repair time
+// with a full recomputation, checking the repaired distances each time
+// Usage: ./dynamic_shortest_paths bench [side] [batches] [batch size]
+void runBenchmark(int side, int batches, int batchSize){
+  int n = side * side;
+  vector<Edge> edges = buildGridEdges(side, 42);
+  DynamicShortestPaths tree(n, edges, 0);
+  mt19937 rng(7);
+  uniform_int_distribution<int> weight(1, 100);
+
+  double repairSeconds = 0, recomputeSeconds = 0;
+  long long touched = 0;
+  int mismatches = 0;
+  for(int b = 0; b < batches; b++){
+    vector<WeightUpdate> updates;
+    for(int i = 0; i < batchSize; i++){
+      WeightUpdate update = {(int)(rng() % edges.size()), weight(rng)};
+      edges[update.edge].weight = update.weight;
+      updates.push_back(update);
+    }
+    auto t0 = chrono::steady_clock::now();
+    touched += tree.applyUpdates(updates);
+    auto t1 = chrono::steady_clock::now();
+    vector<int> expected = recomputeDistances(n, edges, 0);
+    auto t2 = chrono::steady_clock::now();
+    repairSeconds += chrono::duration<double>(t1 - t0).count();
+    recomputeSeconds += chrono::duration<double>(t2 - t1).count();
+    for(int v = 0; v < n; v++){
+      mismatches += tree.distance(v) != expected[v];
+    }
+  }
+
+  cout << "Grid " << side << "x" << side << ", " << batches << " batches of " << batchSize << " updates" << endl;
+  cout << "  repair:     " << repairSeconds * 1000 / batches << " ms/batch, "
+       << touched / batches << " vertices touched/batch" << endl;
+  cout << "  recompute:  " << recomputeSeconds * 1000 / batches << " ms/batch, " << n << " vertices" << endl;
+  cout << "  mismatching distances: " << mismatches << endl;
+}
+
+// Main function: live weight changes on the small example map
+int main(int argc, char* argv[]){
+
+  if(argc > 1 && string(argv[1]) == "bench"){
+    int side = argc > 2 ? stoi(argv[2]) : 300;
+    int batches = argc > 3 ? stoi(argv[3]) : 20;
+    int batchSize = argc > 4 ? stoi(argv[4]) : 10;
+    runBenchmark(side, batches, batchSize);
+    return 0;
+  }
+
+  // Graph structure (ids: A=0, B=1, C=2, D=3):
+  //   A --10--> B --15--> D
+  //    \                 /
+  //     5----> C --20---
+  vector<string> names = {"A", "B", "C", "D"};
+  DynamicShortestPaths tree(4, {{0, 1, 10}, {0, 2, 5}, {1, 3, 15}, {2, 3, 20}}, 0);
+
+  // Follows the tree edges back from D
+  auto printRoute = [&](){
+    vector<int> path;
+    for(int v = 3; v != -1; v = tree.parent(v) == -1 ? -1 : tree.edgeSource(tree.parent(v))){
+      path.push_back(v);
+    }
+    reverse(path.begin(), path.end());
+    cout << "  A to D: " << tree.distance(3) << " via";
+    for(int v : path){
+      cout << " " << names[v];
+    }
+    cout << endl;
+  };
+  printRoute();
+
+  // Traffic jam on C -> D, then it clears and A -> B gets faster too
+  int cd = tree.findEdge(2, 3);
+  int ab = tree.findEdge(0, 1);
+  cout << "Jam on C -> D (weight 40): repaired " << tree.applyUpdates({{cd, 40}}) << " vertices" << endl;
+  printRoute();
+  cout << "Jam clears, A -> B now 4: repaired " << tree.applyUpdates({{cd, 20}, {ab, 4}}) << " vertices" << endl;
+  printRoute();
+
+  return 0;
+}
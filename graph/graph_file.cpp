@@ -0,0 +1,445 @@
+#include<iostream>
+#include<fstream>
+#include<vector>
+#include<string>
+#include<string_view>
+#include<algorithm>
+#include<queue>
+#include<climits>
+#include<cstdint>
+#include<cstdio>
+#include<cstring>
+#include<chrono>
+#include<random>
+#include<fcntl.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<unistd.h>
+using namespace std;
+
+// Binary on-disk navigation graph with zero-copy loading
+//
+// The file holds the CSR arrays and the place names exactly as they are
+// used in memory, so loading is a single mmap: queries read the mapped
+// pages directly, nothing is parsed or copied, and every process that maps
+// the same file shares one copy in the page cache.
+//
+// Layout (little-endian, every section starts on a 64-byte boundary):
+//   header       GraphFileHeader (72 bytes, padded to 128)
+//   offsets      uint64[V + 1]  edge range of each vertex
+//   targets      uint32[E]      head vertex of each edge
+//   weights      int32[E]       weight of each edge
+//   nameOffsets  uint64[V + 1]  byte range of each name in nameData
+//   nameData     char[N]        all names back to back, no terminators
+
+// A single directed, weighted edge between two vertex ids
+struct Edge{
+  int from;
+  int to;
+  int weight;
+};
+
+const char graphFileMagic[8] = {'N', 'A', 'V', 'G', 'R', 'A', 'P', 'H'};
+const uint32_t graphFileVersion = 1;
+
+struct GraphFileHeader{
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+  uint64_t vertexCount;
+  uint64_t edgeCount;
+  uint64_t nameBytes;
+  uint64_t targetsPosition;      // Byte position of each section in the file
+  uint64_t weightsPosition;
+  uint64_t nameOffsetsPosition;
+  uint64_t nameDataPosition;
+};
+static_assert(sizeof(GraphFileHeader) == 72, "header layout must not change");
+
+// Sections are aligned to cache lines
+static uint64_t alignUp(uint64_t position){
+  return (position + 63) & ~(uint64_t)63;
+}
+
+static void writePadding(ofstream& out, uint64_t& position){
+  static const char zeros[64] = {};
+  uint64_t aligned = alignUp(position);
+  out.write(zeros, aligned - position);
+  position = aligned;
+}
+
+template<typename T>
+static void writeSection(ofstream& out, uint64_t& position, const vector<T>& values){
+  writePadding(out, position);
+  out.write((const char*)values.data(), values.size() * sizeof(T));
+  position += values.size() * sizeof(T);
+}
+
+// Writes a graph in the format above. names may be empty (vertices are then
+// shown by id) or hold one name per vertex
+// Returns: false if names has the wrong size or the file could not be written
+bool writeGraphFile(const string& path, int vertexCount, const vector<Edge>& edges, const vector<string>& names){
+  if(!names.empty() && (int)names.size() != vertexCount){
+    return false;
+  }
+
+  // Counting sort of the edges into CSR order
+  vector<uint64_t> offsets(vertexCount + 1, 0);
+  for(const Edge& edge : edges){
+    offsets[edge.from + 1]++;
+  }
+  for(int v = 0; v < vertexCount; v++){
+    offsets[v + 1] += offsets[v];
+  }
+  vector<uint32_t> targets(edges.size());
+  vector<int32_t> weights(edges.size());
+  vector<uint64_t> next(offsets.begin(), offsets.end() - 1);
+  for(const Edge& edge : edges){
+    uint64_t slot = next[edge.from]++;
+    targets[slot] = edge.to;
+    weights[slot] = edge.weight;
+  }
+
+  vector<uint64_t> nameOffsets(1, 0);
+  string nameData;
+  if(!names.empty()){
+    for(const string& name : names){
+      nameData += name;
+      nameOffsets.push_back(nameData.size());
+    }
+  }
+
+  GraphFileHeader header = {};
+  memcpy(header.magic, graphFileMagic, sizeof(header.magic));
+  header.version = graphFileVersion;
+  header.vertexCount = vertexCount;
+  header.edgeCount = edges.size();
+  header.nameBytes = nameData.size();
+  uint64_t position = alignUp(sizeof(header)) + offsets.size() * sizeof(uint64_t);
+  header.targetsPosition = position = alignUp(position);
+  position += targets.size() * sizeof(uint32_t);
+  header.weightsPosition = position = alignUp(position);
+  position += weights.size() * sizeof(int32_t);
+  header.nameOffsetsPosition = position = alignUp(position);
+  position += nameOffsets.size() * sizeof(uint64_t);
+  header.nameDataPosition = alignUp(position);
+
+  ofstream out(path, ios::binary | ios::trunc);
+  if(!out){
+    return false;
+  }
+  out.write((const char*)&header, sizeof(header));
+  position = sizeof(header);
+  writeSection(out, position, offsets);
+  writeSection(out, position, targets);
+  writeSection(out, position, weights);
+  writeSection(out, position, nameOffsets);
+  writePadding(out, position);
+  out.write(nameData.data(), nameData.size());
+  return (bool)out;
+}
+
+// Read-only view of a graph file mapped into memory
+// open() checks the header and that every section fits inside the file,
+// which takes O(1) time whatever the graph size. verify() additionally
+// walks all arrays (O(V + E)) for files that come from an untrusted source
+class MappedGraph{
+  public:
+    MappedGraph() : base(nullptr), length(0), header(nullptr), offsets(nullptr), targets(nullptr),
+                    weights(nullptr), nameOffsets(nullptr), nameData(nullptr){}
+
+    ~MappedGraph(){
+      close();
+    }
+
+    MappedGraph(const MappedGraph&) = delete;
+    MappedGraph& operator=(const MappedGraph&) = delete;
+
+    // Maps the file. Returns false (with the reason in error) if it cannot
+    // be opened or is not a valid graph file of this version
+    bool open(const string& path, string& error){
+      close();
+      int fd = ::open(path.c_str(), O_RDONLY);
+      if(fd < 0){
+        error = "cannot open " + path;
+        return false;
+      }
+      struct stat info;
+      if(fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(GraphFileHeader)){
+        ::close(fd);
+        error = "file too small for a graph header";
+        return false;
+      }
+      length = info.st_size;
+      void* mapping = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+      ::close(fd);  // The mapping keeps the file alive
+      if(mapping == MAP_FAILED){
+        length = 0;
+        error = "mmap failed";
+        return false;
+      }
+      base = (const char*)mapping;
+      if(!checkLayout(error)){
+        close();
+        return false;
+      }
+      return true;
+    }
+
+    void close(){
+      if(base != nullptr){
+        munmap((void*)base, length);
+      }
+      base = nullptr;
+      length = 0;
+      header = nullptr;
+    }
+
+    // Full structural check: offsets are monotonic and every target is a
+    // valid vertex id
+    bool verify() const{
+      uint64_t n = vertexCount();
+      for(uint64_t v = 0; v < n; v++){
+        if(offsets[v] > offsets[v + 1] || (nameOffsets != nullptr && nameOffsets[v] > nameOffsets[v + 1])){
+          return false;
+        }
+      }
+      for(uint64_t e = 0; e < edgeCount(); e++){
+        if(targets[e] >= n){
+          return false;
+        }
+      }
+      return true;
+    }
+
+    uint64_t vertexCount() const{
+      return header->vertexCount;
+    }
+
+    uint64_t edgeCount() const{
+      return header->edgeCount;
+    }
+
+    // Edge range of a vertex: edges edgeBegin(v) .. edgeEnd(v) - 1
+    uint64_t edgeBegin(uint64_t vertex) const{
+      return offsets[vertex];
+    }
+
+    uint64_t edgeEnd(uint64_t vertex) const{
+      return offsets[vertex + 1];
+    }
+
+    uint32_t target(uint64_t edge) const{
+      return targets[edge];
+    }
+
+    int32_t weight(uint64_t edge) const{
+      return weights[edge];
+    }
+
+    // Name of a vertex as a view into the mapped file, empty if unnamed
+    string_view name(uint64_t vertex) const{
+      if(nameOffsets == nullptr){
+        return string_view();
+      }
+      return string_view(nameData + nameOffsets[vertex], nameOffsets[vertex + 1] - nameOffsets[vertex]);
+    }
+
+  private:
+    const char* base;
+    size_t length;
+    const GraphFileHeader* header;
+    const uint64_t* offsets;
+    const uint32_t* targets;
+    const int32_t* weights;
+    const uint64_t* nameOffsets;  // nullptr when the file has no names
+    const char* nameData;
+
+    // True if [position, position + bytes) lies inside the file, 64-byte aligned
+    bool sectionFits(uint64_t position, uint64_t bytes) const{
+      return position % 64 == 0 && position <= length && bytes <= length - position;
+    }
+
+    bool checkLayout(string& error){
+      header = (const GraphFileHeader*)base;
+      if(memcmp(header->magic, graphFileMagic, sizeof(header->magic)) != 0){
+        error = "not a graph file";
+        return false;
+      }
+      if(header->version != graphFileVersion){
+        error = "unsupported graph file version " + to_string(header->version);
+        return false;
+      }
+      uint64_t n = header->vertexCount, m = header->edgeCount;
+      if(n >= UINT32_MAX || m > length || n > length){
+        error = "vertex or edge count out of range";
+        return false;
+      }
+      uint64_t offsetsPosition = alignUp(sizeof(GraphFileHeader));
+      bool hasNames = header->nameBytes > 0 || n == 0;
+      if(!sectionFits(offsetsPosition, (n + 1) * sizeof(uint64_t))
+         || !sectionFits(header->targetsPosition, m * sizeof(uint32_t))
+         || !sectionFits(header->weightsPosition, m * sizeof(int32_t))
+         || !sectionFits(header->nameOffsetsPosition, (hasNames ? n + 1 : 1) * sizeof(uint64_t))
+         || !sectionFits(header->nameDataPosition, header->nameBytes)){
+        error = "truncated or corrupt graph file";
+        return false;
+      }
+      offsets = (const uint64_t*)(base + offsetsPosition);
+      targets = (const uint32_t*)(base + header->targetsPosition);
+      weights = (const int32_t*)(base + header->weightsPosition);
+      nameOffsets = hasNames ? (const uint64_t*)(base + header->nameOffsetsPosition) : nullptr;
+      nameData = base + header->nameDataPosition;
+      if(offsets[0] != 0 || offsets[n] != m
+         || (nameOffsets != nullptr && (nameOffsets[0] != 0 || nameOffsets[n] != header->nameBytes))){
+        error = "graph file offsets do not match its counts";
+        return false;
+      }
+      return true;
+    }
+};
+
+// Dijkstra's Algorithm directly on the mapped arrays
+// Parameters:
+//   - graph: mapped graph file
+//   - start, destination: vertex ids
+//   - parent: filled with the predecessor of each vertex (-1 if none)
+// Returns: distance of every vertex from start, INT_MAX if not reached
+vector<int> findShortestPath(const MappedGraph& graph, uint32_t start, uint32_t destination, vector<int>& parent){
+  vector<int> distances(graph.vertexCount(), INT_MAX);
+  parent.assign(graph.vertexCount(), -1);
+
+  typedef pair<int, uint32_t> HeapEntry;
+  priority_queue<HeapEntry, vector<HeapEntry>, greater<HeapEntry> > frontier;
+  distances[start] = 0;
+  frontier.push(HeapEntry(0, start));
+
+  while(!frontier.empty()){
+    int currentDistance = frontier.top().first;
+    uint32_t current = frontier.top().second;
+    frontier.pop();
+    if(currentDistance > distances[current]){
+      continue;
+    }
+    if(current == destination){
+      break;
+    }
+    for(uint64_t e = graph.edgeBegin(current); e < graph.edgeEnd(current); e++){
+      uint32_t neighbor = graph.target(e);
+      int newDistance = currentDistance + graph.weight(e);
+      if(newDistance < distances[neighbor]){
+        distances[neighbor] = newDistance;
+        parent[neighbor] = current;
+        frontier.push(HeapEntry(newDistance, neighbor));
+      }
+    }
+  }
+  return distances;
+}
+
+// Road-like side x side grid with random weights in [1, 100] in both directions
+vector<Edge> buildGridEdges(int side, unsigned seed){
+  mt19937 rng(seed);
+  uniform_int_distribution<int> weight(1, 100);
+  vector<Edge> edges;
+  for(int row = 0; row < side; row++){
+    for(int col = 0; col < side; col++){
+      int here = row * side + col;
+      if(col + 1 < side){
+        int w = weight(rng);
+        edges.push_back({here, here + 1, w});
+        edges.push_back({here + 1, here, w});
+      }
+      if(row + 1 < side){
+        int w = weight(rng);
+        edges.push_back({here, here + side, w});
+        edges.push_back({here + side, here, w});
+      }
+    }
+  }
+  return edges;
+}
+
+// Writes a grid graph to a file, then times mapping it and a first query
+// Usage: ./graph_file bench [side] [file]
+void runBenchmark(int side, const string& path){
+  int n = side * side;
+  vector<string> names;
+  for(int v = 0; v < n; v++){
+    names.push_back("place-" + to_string(v));
+  }
+  auto t0 = chrono::steady_clock::now();
+  writeGraphFile(path, n, buildGridEdges(side, 42), names);
+  auto t1 = chrono::steady_clock::now();
+
+  MappedGraph graph;
+  string error;
+  if(!graph.open(path, error)){
+    cout << "Error: " << error << endl;
+    return;
+  }
+  auto t2 = chrono::steady_clock::now();
+  vector<int> parent;
+  vector<int> distances = findShortestPath(graph, 0, n - 1, parent);
+  auto t3 = chrono::steady_clock::now();
+
+  cout << "Grid " << side << "x" << side << ": " << graph.vertexCount() << " vertices, "
+       << graph.edgeCount() << " edges" << endl;
+  cout << "  write: " << chrono::duration<double>(t1 - t0).count() * 1000 << " ms" << endl;
+  cout << "  open (mmap + header check): " << chrono::duration<double>(t2 - t1).count() * 1000 << " ms" << endl;
+  cout << "  corner-to-corner query: " << chrono::duration<double>(t3 - t2).count() * 1000 << " ms, distance "
+       << distances[n - 1] << " to " << graph.name(n - 1) << endl;
+  graph.close();
+  remove(path.c_str());
+}
+
+// Main function: saves the example map, maps it back and routes on it
+int main(int argc, char* argv[]){
+
+  if(argc > 1 && string(argv[1]) == "bench"){
+    int side = argc > 2 ? stoi(argv[2]) : 1000;
+    string path = argc > 3 ? argv[3] : "graph_bench.nav";
+    runBenchmark(side, path);
+    return 0;
+  }
+
+  // Graph structure (ids: A=0, B=1, C=2, D=3):
+  //   A --10--> B --15--> D
+  //    \                 /
+  //     5----> C --20---
+  string path = "example_map.nav";
+  if(!writeGraphFile(path, 4, {{0, 1, 10}, {0, 2, 5}, {1, 3, 15}, {2, 3, 20}}, {"A", "B", "C", "D"})){
+    cout << "Could not write " << path << endl;
+    return 1;
+  }
+
+  MappedGraph graph;
+  string error;
+  if(!graph.open(path, error) || !graph.verify()){
+    cout << "Could not load " << path << ": " << error << endl;
+    return 1;
+  }
+
+  vector<int> parent;
+  vector<int> distances = findShortestPath(graph, 0, 3, parent);
+  if(distances[3] == INT_MAX){
+    cout << "No path found to destination." << endl;
+  }
+  else{
+    cout << "Shortest distance to destination: " << distances[3] << endl;
+    vector<int> path;
+    for(int current = 3; current != -1; current = parent[current]){
+      path.push_back(current);
+    }
+    reverse(path.begin(), path.end());
+    cout << "Shortest Path:" << endl;
+    for(int vertex : path){
+      cout << graph.name(vertex) << " -> ";
+    }
+    cout << "Destination" << endl;
+  }
+
+  graph.close();
+  remove(path.c_str());
+  return 0;
+}
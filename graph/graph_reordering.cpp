@@ -0,0 +1,446 @@
+#include<iostream>
+#include<vector>
+#include<string>
+#include<algorithm>
+#include<numeric>
+#include<queue>
+#include<climits>
+#include<cstdint>
+#include<cstdlib>
+#include<chrono>
+#include<random>
+using namespace std;
+
+// Cache-locality vertex reordering
+//
+// Vertex ids normally follow the order in which places were created, so the
+// neighbours of a vertex sit at unrelated ids and every relaxation touches a
+// different cache line of the distance array. Renumbering the vertices so
+// that neighbours get nearby ids keeps a search's working set compact.
+//
+// Three orders are offered:
+//   - BFS order: ids follow breadth-first discovery
+//   - Reverse Cuthill-McKee: BFS from a peripheral vertex, visiting
+//     neighbours by increasing degree, then reversed; keeps the id
+//     "bandwidth" of every edge small
+//   - Hilbert order: sort by position along a Hilbert curve through the
+//     vertex coordinates, so places close on the map get close ids
+// The chosen permutation is applied to the CSR arrays, names and coordinates.
+
+// A single directed, weighted edge between two vertex ids
+struct Edge{
+  int from;
+  int to;
+  int weight;
+};
+
+// Optional position of a place
+struct Coordinate{
+  double latitude;
+  double longitude;
+};
+
+// CSR graph (as in map_navigation.cpp) with optional names and coordinates
+class CsrGraph{
+  public:
+    vector<int> offsets;
+    vector<int> targets;
+    vector<int> weights;
+    vector<string> names;             // Empty or one per vertex
+    vector<Coordinate> coordinates;   // Empty or one per vertex
+
+    CsrGraph(int vertexCount, const vector<Edge>& edges) : offsets(vertexCount + 1, 0){
+      for(const Edge& edge : edges){
+        offsets[edge.from + 1]++;
+      }
+      for(int v = 0; v < vertexCount; v++){
+        offsets[v + 1] += offsets[v];
+      }
+      targets.resize(edges.size());
+      weights.resize(edges.size());
+      vector<int> next(offsets.begin(), offsets.end() - 1);
+      for(const Edge& edge : edges){
+        int slot = next[edge.from]++;
+        targets[slot] = edge.to;
+        weights[slot] = edge.weight;
+      }
+    }
+
+    int vertexCount() const{
+      return (int)offsets.size() - 1;
+    }
+
+    int degree(int vertex) const{
+      return offsets[vertex + 1] - offsets[vertex];
+    }
+};
+
+// Undirected view used by the orderings: out- and in-neighbours of each vertex
+static void buildSymmetricAdjacency(const CsrGraph& graph, vector<int>& offsets, vector<int>& neighbours){
+  int n = graph.vertexCount();
+  offsets.assign(n + 1, 0);
+  for(int u = 0; u < n; u++){
+    for(int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++){
+      offsets[u + 1]++;
+      offsets[graph.targets[e] + 1]++;
+    }
+  }
+  for(int v = 0; v < n; v++){
+    offsets[v + 1] += offsets[v];
+  }
+  neighbours.resize(offsets[n]);
+  vector<int> next(offsets.begin(), offsets.end() - 1);
+  for(int u = 0; u < n; u++){
+    for(int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++){
+      neighbours[next[u]++] = graph.targets[e];
+      neighbours[next[graph.targets[e]]++] = u;
+    }
+  }
+}
+
+// Breadth-first order over all components, each started at its lowest id
+// Returns: order[newId] = oldId
+vector<int> bfsOrder(const CsrGraph& graph){
+  vector<int> offsets, neighbours;
+  buildSymmetricAdjacency(graph, offsets, neighbours);
+  int n = graph.vertexCount();
+  vector<int> order;
+  order.reserve(n);
+  vector<bool> seen(n, false);
+  for(int root = 0; root < n; root++){
+    if(seen[root]){
+      continue;
+    }
+    seen[root] = true;
+    order.push_back(root);
+    for(size_t i = order.size() - 1; i < order.size(); i++){
+      int u = order[i];
+      for(int j = offsets[u]; j < offsets[u + 1]; j++){
+        if(!seen[neighbours[j]]){
+          seen[neighbours[j]] = true;
+          order.push_back(neighbours[j]);
+        }
+      }
+    }
+  }
+  return order;
+}
+
+// Reverse Cuthill-McKee over all components
+// Each component starts at a pseudo-peripheral vertex: from its lowest-degree
+// vertex, repeatedly jump to the last vertex of a BFS until the BFS depth
+// stops growing
+// Returns: order[newId] = oldId
+vector<int> reverseCuthillMcKeeOrder(const CsrGraph& graph){
+  vector<int> offsets, neighbours;
+  buildSymmetricAdjacency(graph, offsets, neighbours);
+  int n = graph.vertexCount();
+  auto degree = [&](int v){ return offsets[v + 1] - offsets[v]; };
+
+  vector<int> level(n, -1);  // Scratch for the peripheral search, -1 = unseen
+  vector<int> visit;
+  // BFS from root over unplaced vertices; returns depth, last vertex in visit.back()
+  auto eccentricity = [&](int root, const vector<bool>& placed){
+    visit.assign(1, root);
+    level[root] = 0;
+    int depth = 0;
+    for(size_t i = 0; i < visit.size(); i++){
+      int u = visit[i];
+      depth = level[u];
+      for(int j = offsets[u]; j < offsets[u + 1]; j++){
+        int v = neighbours[j];
+        if(!placed[v] && level[v] == -1){
+          level[v] = level[u] + 1;
+          visit.push_back(v);
+        }
+      }
+    }
+    for(int v : visit){
+      level[v] = -1;
+    }
+    return depth;
+  };
+
+  // Vertices by degree, so each component's lowest-degree vertex is found first
+  vector<int> byDegree(n);
+  iota(byDegree.begin(), byDegree.end(), 0);
+  stable_sort(byDegree.begin(), byDegree.end(), [&](int a, int b){ return degree(a) < degree(b); });
+
+  vector<bool> placed(n, false);
+  vector<int> order;
+  order.reserve(n);
+  vector<int> candidates;
+  for(int seed : byDegree){
+    if(placed[seed]){
+      continue;
+    }
+    int root = seed;
+    int depth = eccentricity(root, placed);
+    for(int tries = 0; tries < 8; tries++){
+      int far = visit.back();
+      int farDepth = eccentricity(far, placed);
+      if(farDepth <= depth){
+        break;
+      }
+      root = far;
+      depth = farDepth;
+    }
+
+    // Cuthill-McKee BFS: neighbours in increasing degree order
+    size_t begin = order.size();
+    placed[root] = true;
+    order.push_back(root);
+    for(size_t i = begin; i < order.size(); i++){
+      int u = order[i];
+      candidates.clear();
+      for(int j = offsets[u]; j < offsets[u + 1]; j++){
+        int v = neighbours[j];
+        if(!placed[v]){
+          placed[v] = true;
+          candidates.push_back(v);
+        }
+      }
+      sort(candidates.begin(), candidates.end(), [&](int a, int b){ return degree(a) < degree(b); });
+      order.insert(order.end(), candidates.begin(), candidates.end());
+    }
+  }
+  reverse(order.begin(), order.end());
+  return order;
+}
+
+// Position of (x, y) along a Hilbert curve filling a 2^16 x 2^16 grid
+static uint64_t hilbertIndex(uint32_t x, uint32_t y){
+  uint64_t d = 0;
+  for(uint32_t s = 1u << 15; s > 0; s >>= 1){
+    uint32_t rx = (x & s) > 0;
+    uint32_t ry = (y & s) > 0;
+    d += (uint64_t)s * s * ((3 * rx) ^ ry);
+    // Rotate the quadrant so the curve stays continuous
+    if(ry == 0){
+      if(rx == 1){
+        x = s - 1 - (x & (s - 1));
+        y = s - 1 - (y & (s - 1));
+      }
+      swap(x, y);
+    }
+    x &= s - 1;
+    y &= s - 1;
+  }
+  return d;
+}
+
+// Hilbert-curve order of the vertex coordinates
+// Returns: order[newId] = oldId, or an empty vector if the graph has no coordinates
+vector<int> hilbertOrder(const CsrGraph& graph){
+  int n = graph.vertexCount();
+  if((int)graph.coordinates.size() != n){
+    return vector<int>();
+  }
+  double minLat = 1e300, maxLat = -1e300, minLon = 1e300, maxLon = -1e300;
+  for(const Coordinate& c : graph.coordinates){
+    minLat = min(minLat, c.latitude);
+    maxLat = max(maxLat, c.latitude);
+    minLon = min(minLon, c.longitude);
+    maxLon = max(maxLon, c.longitude);
+  }
+  double latScale = maxLat > minLat ? 65535.0 / (maxLat - minLat) : 0;
+  double lonScale = maxLon > minLon ? 65535.0 / (maxLon - minLon) : 0;
+
+  vector<pair<uint64_t, int> > keys(n);
+  for(int v = 0; v < n; v++){
+    uint32_t x = (uint32_t)((graph.coordinates[v].longitude - minLon) * lonScale);
+    uint32_t y = (uint32_t)((graph.coordinates[v].latitude - minLat) * latScale);
+    keys[v] = make_pair(hilbertIndex(x, y), v);
+  }
+  sort(keys.begin(), keys.end());
+  vector<int> order(n);
+  for(int i = 0; i < n; i++){
+    order[i] = keys[i].second;
+  }
+  return order;
+}
+
+// Renumbers the graph: vertex order[i] becomes vertex i. Edges keep their
+// relative order inside each range, names and coordinates move with their
+// vertex. newId receives the old -> new id mapping for translating queries
+CsrGraph applyOrder(const CsrGraph& graph, const vector<int>& order, vector<int>& newId){
+  int n = graph.vertexCount();
+  newId.assign(n, -1);
+  for(int i = 0; i < n; i++){
+    newId[order[i]] = i;
+  }
+
+  vector<Edge> edges;
+  edges.reserve(graph.targets.size());
+  for(int i = 0; i < n; i++){
+    int old = order[i];
+    for(int e = graph.offsets[old]; e < graph.offsets[old + 1]; e++){
+      edges.push_back({i, newId[graph.targets[e]], graph.weights[e]});
+    }
+  }
+  CsrGraph result(n, edges);
+  if(!graph.names.empty()){
+    result.names.resize(n);
+    for(int i = 0; i < n; i++){
+      result.names[i] = graph.names[order[i]];
+    }
+  }
+  if(!graph.coordinates.empty()){
+    result.coordinates.resize(n);
+    for(int i = 0; i < n; i++){
+      result.coordinates[i] = graph.coordinates[order[i]];
+    }
+  }
+  return result;
+}
+
+// How far apart the endpoints of edges are in id space
+struct LocalityMetrics{
+  double averageGap;       // Mean |from - to| over all edges
+  double nearFraction;     // Share of edges with |from - to| < 16 (same 64-byte line of an int array)
+  int bandwidth;           // Largest |from - to|
+};
+
+LocalityMetrics measureLocality(const CsrGraph& graph){
+  LocalityMetrics metrics = {0, 0, 0};
+  long long near = 0;
+  double gapSum = 0;
+  for(int u = 0; u < graph.vertexCount(); u++){
+    for(int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++){
+      int gap = abs(u - graph.targets[e]);
+      gapSum += gap;
+      near += gap < 16;
+      metrics.bandwidth = max(metrics.bandwidth, gap);
+    }
+  }
+  size_t edges = max<size_t>(1, graph.targets.size());
+  metrics.averageGap = gapSum / edges;
+  metrics.nearFraction = (double)near / edges;
+  return metrics;
+}
+
+// One-to-all Dijkstra, used to time the effect of an order on searches
+long long totalDistance(const CsrGraph& graph, int source){
+  vector<int> distances(graph.vertexCount(), INT_MAX);
+  typedef pair<int, int> HeapEntry;
+  priority_queue<HeapEntry, vector<HeapEntry>, greater<HeapEntry> > frontier;
+  distances[source] = 0;
+  frontier.push(HeapEntry(0, source));
+  while(!frontier.empty()){
+    HeapEntry top = frontier.top();
+    frontier.pop();
+    if(top.first > distances[top.second]){
+      continue;
+    }
+    for(int e = graph.offsets[top.second]; e < graph.offsets[top.second + 1]; e++){
+      int newDistance = top.first + graph.weights[e];
+      if(newDistance < distances[graph.targets[e]]){
+        distances[graph.targets[e]] = newDistance;
+        frontier.push(HeapEntry(newDistance, graph.targets[e]));
+      }
+    }
+  }
+  long long sum = 0;
+  for(int d : distances){
+    sum += d == INT_MAX ? 0 : d;
+  }
+  return sum;
+}
+
+// side x side road grid whose vertex ids are shuffled, as if the places had
+// been created in arbitrary order; coordinates are the grid positions
+CsrGraph buildShuffledGrid(int side, unsigned seed){
+  int n = side * side;
+  mt19937 rng(seed);
+  vector<int> id(n);
+  iota(id.begin(), id.end(), 0);
+  shuffle(id.begin(), id.end(), rng);
+  uniform_int_distribution<int> weight(1, 100);
+
+  vector<Edge> edges;
+  for(int row = 0; row < side; row++){
+    for(int col = 0; col < side; col++){
+      int here = id[row * side + col];
+      if(col + 1 < side){
+        int w = weight(rng);
+        edges.push_back({here, id[row * side + col + 1], w});
+        edges.push_back({id[row * side + col + 1], here, w});
+      }
+      if(row + 1 < side){
+        int w = weight(rng);
+        edges.push_back({here, id[(row + 1) * side + col], w});
+        edges.push_back({id[(row + 1) * side + col], here, w});
+      }
+    }
+  }
+  CsrGraph graph(n, edges);
+  graph.coordinates.resize(n);
+  for(int cell = 0; cell < n; cell++){
+    graph.coordinates[id[cell]] = {(double)(cell / side), (double)(cell % side)};
+  }
+  return graph;
+}
+
+// Prints locality metrics and one-to-all Dijkstra time for each order
+// Usage: ./graph_reordering bench [side]
+void runBenchmark(int side){
+  CsrGraph original = buildShuffledGrid(side, 42);
+  cout << "Shuffled grid " << side << "x" << side << endl;
+
+  auto report = [&](const string& label, const vector<int>& order){
+    vector<int> newId;
+    auto t0 = chrono::steady_clock::now();
+    CsrGraph graph = order.empty() ? original : applyOrder(original, order, newId);
+    double reorderSeconds = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    int source = order.empty() ? 0 : newId[0];
+    auto t1 = chrono::steady_clock::now();
+    long long checksum = totalDistance(graph, source);
+    double searchSeconds = chrono::duration<double>(chrono::steady_clock::now() - t1).count();
+    LocalityMetrics metrics = measureLocality(graph);
+    cout << "  " << label << ": avg gap " << metrics.averageGap << ", near edges "
+         << metrics.nearFraction * 100 << "%, bandwidth " << metrics.bandwidth
+         << ", one-to-all Dijkstra " << searchSeconds * 1000 << " ms";
+    if(!order.empty()){
+      cout << " (permute " << reorderSeconds * 1000 << " ms)";
+    }
+    cout << " [checksum " << checksum << "]" << endl;
+  };
+
+  report("original    ", vector<int>());
+  report("BFS         ", bfsOrder(original));
+  report("RCM         ", reverseCuthillMcKeeOrder(original));
+  report("Hilbert     ", hilbertOrder(original));
+}
+
+// Main function: reorders the small example map and a small shuffled grid
+int main(int argc, char* argv[]){
+
+  if(argc > 1 && string(argv[1]) == "bench"){
+    runBenchmark(argc > 2 ? stoi(argv[2]) : 1000);
+    return 0;
+  }
+
+  // Graph structure (ids: D=0, C=1, A=2, B=3, created in that order):
+  //   A --10--> B --15--> D
+  //    \                 /
+  //     5----> C --20---
+  CsrGraph graph(4, {{2, 3, 10}, {2, 1, 5}, {3, 0, 15}, {1, 0, 20}});
+  graph.names = {"D", "C", "A", "B"};
+
+  vector<int> newId;
+  CsrGraph reordered = applyOrder(graph, reverseCuthillMcKeeOrder(graph), newId);
+  cout << "RCM order:";
+  for(const string& name : reordered.names){
+    cout << " " << name;
+  }
+  cout << endl;
+
+  // The four-place map is too small for ids to be far apart; a shuffled
+  // 8x8 grid shows how much RCM tightens them
+  CsrGraph grid = buildShuffledGrid(8, 42);
+  CsrGraph gridReordered = applyOrder(grid, reverseCuthillMcKeeOrder(grid), newId);
+  LocalityMetrics before = measureLocality(grid), after = measureLocality(gridReordered);
+  cout << "Shuffled 8x8 grid, average edge id gap: " << before.averageGap << " -> " << after.averageGap
+       << ", bandwidth: " << before.bandwidth << " -> " << after.bandwidth << endl;
+  return 0;
+}
@@ -0,0 +1,335 @@
+#include<iostream>
+#include<vector>
+#include<string>
+#include<algorithm>
+#include<climits>
+#include<chrono>
+#include<random>
+using namespace std;
+
+// Isochrones: every place reachable within a travel-cost budget
+//
+// A plain Dijkstra run to completion and filtered afterwards costs time
+// proportional to the whole graph. Here the search never pushes a label
+// above the budget, so it stops by itself once the reachable region is
+// exhausted; with the generation-stamped workspace the reset is O(1) and a
+// query touches only the vertices inside the region (plus their edges).
+//
+// Vertices are settled in non-decreasing distance order, so the result is
+// already sorted by distance. Several nested budgets therefore come out of
+// one search as offsets into the same buffer: ring i is the range
+// [ringEnds[i - 1], ringEnds[i]).
+
+// A single directed, weighted edge between two vertex ids
+struct Edge{
+  int from;
+  int to;
+  int weight;
+};
+
+// Immutable CSR graph (same layout as CsrGraph in map_navigation.cpp)
+class CsrGraph{
+  public:
+    vector<int> offsets;   // Size V + 1: start of each vertex's edge range
+    vector<int> targets;   // Size E: head vertex of each edge
+    vector<int> weights;   // Size E: weight of each edge
+
+    CsrGraph(int vertexCount, const vector<Edge>& edges) : offsets(vertexCount + 1, 0){
+      for(const Edge& edge : edges){
+        offsets[edge.from + 1]++;
+      }
+      for(int v = 0; v < vertexCount; v++){
+        offsets[v + 1] += offsets[v];
+      }
+      targets.resize(edges.size());
+      weights.resize(edges.size());
+      vector<int> next(offsets.begin(), offsets.end() - 1);
+      for(const Edge& edge : edges){
+        int slot = next[edge.from]++;
+        targets[slot] = edge.to;
+        weights[slot] = edge.weight;
+      }
+    }
+
+    int vertexCount() const{
+      return (int)offsets.size() - 1;
+    }
+};
+
+// Reusable Dijkstra state with generation stamps (see QueryWorkspace in
+// map_navigation.cpp): reset() is O(1) and warm searches do not allocate
+class QueryWorkspace{
+  public:
+    typedef pair<int, int> HeapEntry;  // (distance, vertex)
+
+    explicit QueryWorkspace(int vertexCount)
+      : distances(vertexCount), stamps(vertexCount, 0), settledStamps(vertexCount, 0), generation(0){}
+
+    void reset(){
+      generation++;
+      if(generation == 0){
+        fill(stamps.begin(), stamps.end(), 0);
+        fill(settledStamps.begin(), settledStamps.end(), 0);
+        generation = 1;
+      }
+      heap.clear();
+    }
+
+    int distance(int vertex) const{
+      return stamps[vertex] == generation ? distances[vertex] : INT_MAX;
+    }
+
+    void update(int vertex, int distance){
+      distances[vertex] = distance;
+      stamps[vertex] = generation;
+    }
+
+    bool isSettled(int vertex) const{
+      return settledStamps[vertex] == generation;
+    }
+
+    void settle(int vertex){
+      settledStamps[vertex] = generation;
+    }
+
+    bool heapEmpty() const{
+      return heap.empty();
+    }
+
+    void push(int distance, int vertex){
+      heap.push_back(HeapEntry(distance, vertex));
+      push_heap(heap.begin(), heap.end(), greater<HeapEntry>());
+    }
+
+    HeapEntry pop(){
+      pop_heap(heap.begin(), heap.end(), greater<HeapEntry>());
+      HeapEntry top = heap.back();
+      heap.pop_back();
+      return top;
+    }
+
+  private:
+    vector<int> distances;
+    vector<unsigned> stamps;
+    vector<unsigned> settledStamps;
+    vector<HeapEntry> heap;
+    unsigned generation;
+};
+
+// Reachable set of one isochrone query, in non-decreasing distance order
+// vertices[i] is reachable at cost distances[i]; ringEnds has one entry per
+// requested budget (a single entry for a single-budget query)
+struct IsochroneResult{
+  vector<int> vertices;
+  vector<int> distances;
+  vector<size_t> ringEnds;
+
+  size_t size() const{
+    return vertices.size();
+  }
+};
+
+// Runs bounded Dijkstra searches on one graph, reusing its workspace and
+// result buffer between queries
+class IsochroneEngine{
+  public:
+    explicit IsochroneEngine(const CsrGraph& graph)
+      : graph(graph), workspace(graph.vertexCount()), singleBudget(1){}
+
+    // All vertices with distance <= budget from source
+    // The returned reference stays valid until the next query
+    const IsochroneResult& reachable(int source, int budget){
+      singleBudget[0] = budget;
+      return rings(source, singleBudget);
+    }
+
+    // Nested rings for several budgets from one search; budgets must be
+    // non-decreasing. Ring i holds the vertices with
+    // budgets[i - 1] < distance <= budgets[i]
+    const IsochroneResult& rings(int source, const vector<int>& budgets){
+      result.vertices.clear();
+      result.distances.clear();
+      result.ringEnds.clear();
+      if(budgets.empty() || budgets.back() < 0){
+        result.ringEnds.assign(budgets.size(), 0);
+        return result;
+      }
+      search(source, budgets.back());
+
+      // Settle order is sorted by distance, so each ring end is one bound
+      size_t position = 0;
+      for(int budget : budgets){
+        while(position < result.size() && result.distances[position] <= budget){
+          position++;
+        }
+        result.ringEnds.push_back(position);
+      }
+      return result;
+    }
+
+  private:
+    const CsrGraph& graph;
+    QueryWorkspace workspace;
+    IsochroneResult result;
+    vector<int> singleBudget;  // reused by reachable() so queries do not allocate
+
+    // Dijkstra that never queues a label above budget; every settled vertex
+    // is appended to the result
+    void search(int source, int budget){
+      workspace.reset();
+      workspace.update(source, 0);
+      workspace.push(0, source);
+
+      while(!workspace.heapEmpty()){
+        QueryWorkspace::HeapEntry top = workspace.pop();
+        int current = top.second;
+        if(workspace.isSettled(current)){
+          continue;
+        }
+        workspace.settle(current);
+        result.vertices.push_back(current);
+        result.distances.push_back(top.first);
+
+        for(int e = graph.offsets[current]; e < graph.offsets[current + 1]; e++){
+          int neighbor = graph.targets[e];
+          // Compared in long long so budgets near INT_MAX cannot overflow
+          long long newDistance = (long long)top.first + graph.weights[e];
+          if(newDistance <= budget && !workspace.isSettled(neighbor) && newDistance < workspace.distance(neighbor)){
+            workspace.update(neighbor, (int)newDistance);
+            workspace.push((int)newDistance, neighbor);
+          }
+        }
+      }
+    }
+};
+
+// Reference: full Dijkstra then filter, the only option before this file
+vector<int> reachableByFullSearch(const CsrGraph& graph, int source, int budget){
+  vector<int> distances(graph.vertexCount(), INT_MAX);
+  typedef pair<int, int> HeapEntry;
+  vector<HeapEntry> heap;
+  distances[source] = 0;
+  heap.push_back(HeapEntry(0, source));
+  while(!heap.empty()){
+    pop_heap(heap.begin(), heap.end(), greater<HeapEntry>());
+    HeapEntry top = heap.back();
+    heap.pop_back();
+    if(top.first > distances[top.second]){
+      continue;
+    }
+    for(int e = graph.offsets[top.second]; e < graph.offsets[top.second + 1]; e++){
+      int newDistance = top.first + graph.weights[e];
+      if(newDistance < distances[graph.targets[e]]){
+        distances[graph.targets[e]] = newDistance;
+        heap.push_back(HeapEntry(newDistance, graph.targets[e]));
+        push_heap(heap.begin(), heap.end(), greater<HeapEntry>());
+      }
+    }
+  }
+  vector<int> reachable;
+  for(int v = 0; v < graph.vertexCount(); v++){
+    if(distances[v] <= budget){
+      reachable.push_back(v);
+    }
+  }
+  return reachable;
+}
+
+// Road-like side x side grid with random weights in [1, 100] in both directions
+vector<Edge> buildGridEdges(int side, unsigned seed){
+  mt19937 rng(seed);
+  uniform_int_distribution<int> weight(1, 100);
+  vector<Edge> edges;
+  for(int row = 0; row < side; row++){
+    for(int col = 0; col < side; col++){
+      int here = row * side + col;
+      if(col + 1 < side){
+        int w = weight(rng);
+        edges.push_back({here, here + 1, w});
+        edges.push_back({here + 1, here, w});
+      }
+      if(row + 1 < side){
+        int w = weight(rng);
+        edges.push_back({here, here + side, w});
+        edges.push_back({here + side, here, w});
+      }
+    }
+  }
+  return edges;
+}
+
+// Times isochrones of growing budgets against full search + filter, and
+// checks that both return the same vertex set
+// Usage: ./isochrone bench [side] [queries]
+void runBenchmark(int side, int queries){
+  CsrGraph graph(side * side, buildGridEdges(side, 42));
+  IsochroneEngine engine(graph);
+  mt19937 rng(7);
+  vector<int> sources(queries);
+  for(int& source : sources){
+    source = rng() % graph.vertexCount();
+  }
+
+  cout << "Grid " << side << "x" << side << ", " << queries << " queries per budget" << endl;
+  for(int budget : {500, 2000, 8000, 32000}){
+    size_t reached = 0;
+    auto t0 = chrono::steady_clock::now();
+    for(int source : sources){
+      reached += engine.reachable(source, budget).size();
+    }
+    double bounded = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+
+    size_t fullReached = 0;
+    auto t1 = chrono::steady_clock::now();
+    for(int source : sources){
+      fullReached += reachableByFullSearch(graph, source, budget).size();
+    }
+    double full = chrono::duration<double>(chrono::steady_clock::now() - t1).count();
+
+    // Checked outside both timers
+    bool same = fullReached == reached;
+    for(int source : sources){
+      vector<int> expected = reachableByFullSearch(graph, source, budget);
+      vector<int> got = engine.reachable(source, budget).vertices;
+      sort(got.begin(), got.end());
+      same = same && got == expected;
+    }
+
+    cout << "  budget " << budget << ": " << reached / queries << " places on average, isochrone "
+         << bounded / queries * 1e6 << " us, full search + filter " << full / queries * 1e6
+         << " us" << (same ? "" : " (MISMATCH)") << endl;
+  }
+}
+
+// Main function: isochrone rings on a small example map
+int main(int argc, char* argv[]){
+
+  if(argc > 1 && string(argv[1]) == "bench"){
+    int side = argc > 2 ? stoi(argv[2]) : 500;
+    int queries = argc > 3 ? stoi(argv[3]) : 20;
+    runBenchmark(side, queries);
+    return 0;
+  }
+
+  // Graph structure (ids: A=0, B=1, C=2, D=3):
+  //   A --10--> B --15--> D
+  //    \                 /
+  //     5----> C --20---
+  vector<string> names = {"A", "B", "C", "D"};
+  CsrGraph graph(4, {{0, 1, 10}, {0, 2, 5}, {1, 3, 15}, {2, 3, 20}});
+  IsochroneEngine engine(graph);
+
+  vector<int> budgets = {5, 15, 30};
+  const IsochroneResult& result = engine.rings(0, budgets);
+  size_t begin = 0;
+  for(size_t ring = 0; ring < budgets.size(); ring++){
+    cout << "Within " << budgets[ring] << " of A:";
+    for(size_t i = begin; i < result.ringEnds[ring]; i++){
+      cout << " " << names[result.vertices[i]] << "(" << result.distances[i] << ")";
+    }
+    cout << endl;
+    begin = result.ringEnds[ring];
+  }
+
+  return 0;
+}
@@ -1,7 +1,13 @@
 #include<iostream>
 #include<unordered_map>
 #include<set>
+#include<algorithm>
 #include<vector>
+#include<queue>
+#include<string>
+#include<climits>
+#include<chrono>
+#include<random>
 using namespace std;
 
 // Class representing a node/vertex in the graph
@@ -29,13 +35,14 @@ class Place{
     }
 };
 
-// Dijkstra's Algorithm: finds shortest path from start to destination
+// Reference Dijkstra: picks the next place by scanning every known distance
+// Runs in O(V^2); kept only as the baseline for runBenchmark()
 // Parameters:
 //   - start: pointer to starting node
 //   - destination: pointer to destination node
 //   - parent: reference map to track path (for reconstruction later)
 // Returns: map of all places and their shortest distances from start
-unordered_map<Place*, int> findShortestPath(Place* start, Place* destination, unordered_map<Place*, Place*>& parent){
+unordered_map<Place*, int> findShortestPathLinearScan(Place* start, Place* destination, unordered_map<Place*, Place*>& parent){
   
   // Map to store the shortest distance from start to each place
   unordered_map<Place*, int> distances;
@@ -95,6 +102,66 @@ unordered_map<Place*, int> findShortestPath(Place* start, Place* destination, un
   return distances;
 }
 
+// Dijkstra's Algorithm: finds shortest path from start to destination
+// Uses a binary min-heap with lazy deletion: a place may sit in the heap
+// several times, stale entries (larger than the recorded distance) are skipped
+// Stops as soon as destination is settled, so only the part of the graph
+// closer than destination is explored. Runs in O((V + E) log V)
+// Parameters:
+//   - start: pointer to starting node
+//   - destination: pointer to destination node
+//   - parent: reference map to track path (for reconstruction later)
+// Returns: map of every place reached and its distance from start
+//          (exact for settled places, tentative for the rest of the frontier)
+unordered_map<Place*, int> findShortestPath(Place* start, Place* destination, unordered_map<Place*, Place*>& parent){
+  
+  // Map to store the shortest distance from start to each place
+  unordered_map<Place*, int> distances;
+  
+  // Min-heap of (distance, place): the top is always the closest unsettled place
+  typedef pair<int, Place*> HeapEntry;
+  priority_queue<HeapEntry, vector<HeapEntry>, greater<HeapEntry> > frontier;
+  
+  // Distance from start to itself is 0
+  distances[start] = 0;
+  frontier.push(HeapEntry(0, start));
+  
+  while(!frontier.empty()){
+    
+    // Take the closest place off the heap
+    int currentDistance = frontier.top().first;
+    Place* current = frontier.top().second;
+    frontier.pop();
+    
+    // Skip stale entries: a shorter distance was already recorded for this place
+    if(currentDistance > distances[current]){
+      continue;
+    }
+    
+    // Destination is settled, its distance can no longer improve
+    if(current == destination){
+      break;
+    }
+    
+    // Relax edges: check all neighbors of the current place
+    for(const auto& neighbor : current->neighbours){
+      
+      int newDistance = currentDistance + neighbor.second;
+      
+      // Insert or lower the neighbor's distance and push a new heap entry
+      auto found = distances.find(neighbor.first);
+      if(found == distances.end() || found->second > newDistance){
+        distances[neighbor.first] = newDistance;
+        parent[neighbor.first] = current;
+        frontier.push(HeapEntry(newDistance, neighbor.first));
+      }
+    }
+  }
+  
+  // Return the map of shortest distances
+  return distances;
+}
+
 // Function to reconstruct the actual path from start to destination
 // Uses the parent map to backtrack from destination to start
 // Parameters:
@@ -109,18 +176,730 @@ vector<Place*> reconstructPath(Place* start, Place* destination, const unordered
   
   // Backtrack from destination to start using parent pointers
   while(current != start){
-    path.insert(path.begin(), current);  // Insert at beginning to maintain correct order
-    current = parent.at(current);        // Move to parent node
+    path.push_back(current);        // Collected in reverse order
+    current = parent.at(current);   // Move to parent node
+  }
+  
+  // Add the starting point, then flip once to get start -> destination
+  path.push_back(start);
+  reverse(path.begin(), path.end());
+  
+  return path;
+}
+
+// A single directed, weighted edge between two vertex ids
+struct Edge{
+  int from;
+  int to;
+  int weight;
+};
+
+// Immutable compressed sparse row (CSR) form of the map
+// Places get dense ids 0..V-1; the out-edges of vertex v are stored
+// contiguously at positions offsets[v] .. offsets[v + 1] - 1 of the
+// parallel targets/weights arrays. Costs 8 bytes per edge plus 4 per
+// vertex, and a relaxation scans one contiguous range instead of hash buckets
+class CsrGraph{
+  public:
+    vector<int> offsets;   // Size V + 1: start of each vertex's edge range
+    vector<int> targets;   // Size E: head vertex of each edge
+    vector<int> weights;   // Size E: weight of each edge
+    vector<string> names;  // Size V: place names (empty when built from an edge list)
+    
+    // Builds the graph from an edge list over vertices 0..vertexCount-1
+    // Edges are bucketed by source with a counting sort, so the order of
+    // edges inside one vertex's range follows their order in the input
+    CsrGraph(int vertexCount, const vector<Edge>& edges) : offsets(vertexCount + 1, 0){
+      for(const Edge& edge : edges){
+        offsets[edge.from + 1]++;
+      }
+      for(int v = 0; v < vertexCount; v++){
+        offsets[v + 1] += offsets[v];
+      }
+      
+      targets.resize(edges.size());
+      weights.resize(edges.size());
+      vector<int> next(offsets.begin(), offsets.end() - 1);  // Next free slot per vertex
+      for(const Edge& edge : edges){
+        int slot = next[edge.from]++;
+        targets[slot] = edge.to;
+        weights[slot] = edge.weight;
+      }
+    }
+    
+    // Builds the graph from Place objects linked with addNeighbour
+    // Every place reachable from the given ones is included; ids follow the
+    // order of the input first, then discovery order. idOf receives the
+    // Place* -> id mapping so callers can translate queries
+    static CsrGraph fromPlaces(const vector<Place*>& places, unordered_map<Place*, int>& idOf){
+      vector<Place*> byId;
+      idOf.clear();
+      for(Place* place : places){
+        if(idOf.count(place) == 0){
+          idOf[place] = (int)byId.size();
+          byId.push_back(place);
+        }
+      }
+      
+      // Walk the adjacency, giving ids to neighbours not in the input list
+      vector<Edge> edges;
+      for(size_t i = 0; i < byId.size(); i++){
+        for(const auto& neighbor : byId[i]->getNeighbours()){
+          auto found = idOf.find(neighbor.first);
+          int to;
+          if(found == idOf.end()){
+            to = (int)byId.size();
+            idOf[neighbor.first] = to;
+            byId.push_back(neighbor.first);
+          }
+          else{
+            to = found->second;
+          }
+          edges.push_back({(int)i, to, neighbor.second});
+        }
+      }
+      
+      CsrGraph graph((int)byId.size(), edges);
+      graph.names.reserve(byId.size());
+      for(Place* place : byId){
+        graph.names.push_back(place->getName());
+      }
+      return graph;
+    }
+    
+    int vertexCount() const{
+      return (int)offsets.size() - 1;
+    }
+    
+    int edgeCount() const{
+      return (int)targets.size();
+    }
+    
+    // Builds the transpose: every edge u -> v becomes v -> u with the same weight
+    // Searching it from destination gives distances *to* destination
+    CsrGraph reversed() const{
+      vector<Edge> edges;
+      edges.reserve(targets.size());
+      for(int v = 0; v < vertexCount(); v++){
+        for(int e = offsets[v]; e < offsets[v + 1]; e++){
+          edges.push_back({targets[e], v, weights[e]});
+        }
+      }
+      CsrGraph transpose(vertexCount(), edges);
+      transpose.names = names;
+      return transpose;
+    }
+    
+    // Returns the place name of a vertex, or its id when the graph has no names
+    string getName(int vertex) const{
+      return names.empty() ? to_string(vertex) : names[vertex];
+    }
+};
+
+// Dijkstra's Algorithm on the CSR graph
+// Same lazy-heap search as the Place version, with flat arrays instead of maps
+// Parameters:
+//   - graph: CSR graph to search
+//   - start, destination: vertex ids
+//   - parent: filled with the predecessor of each vertex (-1 if none)
+// Returns: distance of every vertex from start, INT_MAX if not reached
+vector<int> findShortestPath(const CsrGraph& graph, int start, int destination, vector<int>& parent){
+  
+  vector<int> distances(graph.vertexCount(), INT_MAX);
+  parent.assign(graph.vertexCount(), -1);
+  
+  typedef pair<int, int> HeapEntry;
+  priority_queue<HeapEntry, vector<HeapEntry>, greater<HeapEntry> > frontier;
+  
+  distances[start] = 0;
+  frontier.push(HeapEntry(0, start));
+  
+  while(!frontier.empty()){
+    int currentDistance = frontier.top().first;
+    int current = frontier.top().second;
+    frontier.pop();
+    
+    // Skip stale entries and stop once destination is settled
+    if(currentDistance > distances[current]){
+      continue;
+    }
+    if(current == destination){
+      break;
+    }
+    
+    // Relax the contiguous edge range of the current vertex
+    for(int e = graph.offsets[current]; e < graph.offsets[current + 1]; e++){
+      int neighbor = graph.targets[e];
+      int newDistance = currentDistance + graph.weights[e];
+      if(newDistance < distances[neighbor]){
+        distances[neighbor] = newDistance;
+        parent[neighbor] = current;
+        frontier.push(HeapEntry(newDistance, neighbor));
+      }
+    }
   }
   
-  // Add the starting point at the beginning
-  path.insert(path.begin(), start);
+  return distances;
+}
+
+// Rebuilds the vertex path start -> destination from a CSR parent array
+// Returns an empty vector if destination was not reached
+vector<int> reconstructPath(int start, int destination, const vector<int>& parent){
+  vector<int> path;
+  if(start != destination && parent[destination] == -1){
+    return path;
+  }
   
+  // Walk back to start, then reverse once instead of inserting at the front
+  for(int current = destination; current != start; current = parent[current]){
+    path.push_back(current);
+  }
+  path.push_back(start);
+  reverse(path.begin(), path.end());
   return path;
 }
 
+// Reusable per-query state for Dijkstra on a CsrGraph
+// Owns flat distance/parent/settled arrays sized to the graph plus the heap
+// storage, so a warm query does not allocate. Instead of clearing the arrays
+// before each query, every slot carries the generation it was written in;
+// reset() bumps the generation, which makes all old slots read as "unset"
+// in O(1). Not thread-safe: give each query thread its own workspace
+class QueryWorkspace{
+  public:
+    typedef pair<int, int> HeapEntry;  // (distance, vertex)
+    
+    explicit QueryWorkspace(int vertexCount)
+      : distances(vertexCount), parents(vertexCount),
+        stamps(vertexCount, 0), settledStamps(vertexCount, 0), generation(0), settledCount(0){}
+    
+    // Starts a new query: forgets all distances, parents and settled marks
+    void reset(){
+      generation++;
+      if(generation == 0){
+        // Counter wrapped around: clear the stamps once so no stale slot
+        // can match a reused generation value
+        fill(stamps.begin(), stamps.end(), 0);
+        fill(settledStamps.begin(), settledStamps.end(), 0);
+        generation = 1;
+      }
+      heap.clear();  // Keeps its capacity
+      settledCount = 0;
+    }
+    
+    int vertexCount() const{
+      return (int)distances.size();
+    }
+    
+    // Distance recorded in this query, INT_MAX if the vertex was not reached
+    int distance(int vertex) const{
+      return stamps[vertex] == generation ? distances[vertex] : INT_MAX;
+    }
+    
+    // Predecessor recorded in this query, -1 if none
+    int parent(int vertex) const{
+      return stamps[vertex] == generation ? parents[vertex] : -1;
+    }
+    
+    void update(int vertex, int distance, int parent){
+      distances[vertex] = distance;
+      parents[vertex] = parent;
+      stamps[vertex] = generation;
+    }
+    
+    bool isSettled(int vertex) const{
+      return settledStamps[vertex] == generation;
+    }
+    
+    void settle(int vertex){
+      settledStamps[vertex] = generation;
+      settledCount++;
+    }
+    
+    // Number of vertices settled since the last reset (search effort)
+    int settled() const{
+      return settledCount;
+    }
+    
+    // Min-heap on the reusable heap vector
+    bool heapEmpty() const{
+      return heap.empty();
+    }
+    
+    void push(int distance, int vertex){
+      heap.push_back(HeapEntry(distance, vertex));
+      push_heap(heap.begin(), heap.end(), greater<HeapEntry>());
+    }
+    
+    // Smallest key in the heap (may belong to an already settled vertex)
+    int topDistance() const{
+      return heap.front().first;
+    }
+    
+    HeapEntry pop(){
+      pop_heap(heap.begin(), heap.end(), greater<HeapEntry>());
+      HeapEntry top = heap.back();
+      heap.pop_back();
+      return top;
+    }
+    
+  private:
+    vector<int> distances;
+    vector<int> parents;
+    vector<unsigned> stamps;         // Generation in which distances/parents were written
+    vector<unsigned> settledStamps;  // Generation in which the vertex was settled
+    vector<HeapEntry> heap;
+    unsigned generation;
+    int settledCount;
+};
+
+// Dijkstra's Algorithm on the CSR graph using a reusable workspace
+// The workspace is reset first, so it can be reused for query after query
+// Returns: distance from start to destination, INT_MAX if unreachable
+//          (distances and parents of all reached vertices stay readable
+//          in the workspace until the next query)
+int findShortestPath(const CsrGraph& graph, int start, int destination, QueryWorkspace& workspace){
+  workspace.reset();
+  workspace.update(start, 0, -1);
+  workspace.push(0, start);
+  
+  while(!workspace.heapEmpty()){
+    QueryWorkspace::HeapEntry top = workspace.pop();
+    int current = top.second;
+    
+    // Skip duplicate entries of an already settled vertex
+    if(workspace.isSettled(current)){
+      continue;
+    }
+    workspace.settle(current);
+    if(current == destination){
+      return top.first;
+    }
+    
+    for(int e = graph.offsets[current]; e < graph.offsets[current + 1]; e++){
+      int neighbor = graph.targets[e];
+      int newDistance = top.first + graph.weights[e];
+      if(!workspace.isSettled(neighbor) && newDistance < workspace.distance(neighbor)){
+        workspace.update(neighbor, newDistance, current);
+        workspace.push(newDistance, neighbor);
+      }
+    }
+  }
+  
+  return INT_MAX;
+}
+
+// Writes the path start -> destination of the last query into path
+// The buffer is cleared but keeps its capacity, so a reused buffer does not
+// allocate. Runs in time linear in the path length
+// Returns: number of vertices on the path, 0 if destination was not reached
+size_t reconstructPath(int start, int destination, const QueryWorkspace& workspace, vector<int>& path){
+  path.clear();
+  if(workspace.distance(destination) == INT_MAX){
+    return 0;
+  }
+  for(int current = destination; current != start; current = workspace.parent(current)){
+    path.push_back(current);
+  }
+  path.push_back(start);
+  reverse(path.begin(), path.end());
+  return path.size();
+}
+
+// State for bidirectional Dijkstra: one workspace per search direction
+// plus the vertex where the best forward and backward paths meet
+struct BidirectionalWorkspace{
+  QueryWorkspace forward;
+  QueryWorkspace backward;
+  int meeting;
+  
+  explicit BidirectionalWorkspace(int vertexCount)
+    : forward(vertexCount), backward(vertexCount), meeting(-1){}
+  
+  int settled() const{
+    return forward.settled() + backward.settled();
+  }
+};
+
+// Settles one vertex of one direction of the bidirectional search and
+// relaxes its edges in that direction's graph. Whenever a relaxed vertex is
+// already reached by the other direction, the path through it becomes a
+// candidate for the best total distance
+static void bidirectionalStep(const CsrGraph& graph, QueryWorkspace& self, const QueryWorkspace& other,
+                              int& best, int& meeting){
+  QueryWorkspace::HeapEntry top = self.pop();
+  int current = top.second;
+  if(self.isSettled(current)){
+    return;
+  }
+  self.settle(current);
+  
+  for(int e = graph.offsets[current]; e < graph.offsets[current + 1]; e++){
+    int neighbor = graph.targets[e];
+    int newDistance = top.first + graph.weights[e];
+    if(!self.isSettled(neighbor) && newDistance < self.distance(neighbor)){
+      self.update(neighbor, newDistance, current);
+      self.push(newDistance, neighbor);
+    }
+    int otherDistance = other.distance(neighbor);
+    if(otherDistance != INT_MAX && self.distance(neighbor) + otherDistance < best){
+      best = self.distance(neighbor) + otherDistance;
+      meeting = neighbor;
+    }
+  }
+}
+
+// Bidirectional Dijkstra for one start and one destination
+// Grows a forward search from start on graph and a backward search from
+// destination on reverseGraph (graph.reversed()), always advancing the side
+// whose smallest key is lower. Stops when the two smallest keys add up to
+// at least the best path seen so far: no path through an unsettled vertex
+// can be shorter. Settles about half as many vertices as findShortestPath
+// on road-like graphs
+// Returns: distance from start to destination, INT_MAX if unreachable
+int findShortestPathBidirectional(const CsrGraph& graph, const CsrGraph& reverseGraph,
+                                  int start, int destination, BidirectionalWorkspace& workspace){
+  QueryWorkspace& forward = workspace.forward;
+  QueryWorkspace& backward = workspace.backward;
+  forward.reset();
+  backward.reset();
+  
+  forward.update(start, 0, -1);
+  forward.push(0, start);
+  backward.update(destination, 0, -1);
+  backward.push(0, destination);
+  
+  int best = start == destination ? 0 : INT_MAX;
+  workspace.meeting = start == destination ? start : -1;
+  
+  while(!forward.heapEmpty() && !backward.heapEmpty()){
+    // Stopping rule; the sum is done in 64 bits so INT_MAX keys cannot overflow
+    if((long long)forward.topDistance() + backward.topDistance() >= best){
+      break;
+    }
+    if(forward.topDistance() <= backward.topDistance()){
+      bidirectionalStep(graph, forward, backward, best, workspace.meeting);
+    }
+    else{
+      bidirectionalStep(reverseGraph, backward, forward, best, workspace.meeting);
+    }
+  }
+  
+  return best;
+}
+
+// Writes the path found by findShortestPathBidirectional into path by
+// stitching the forward parent chain (start -> meeting) to the backward
+// parent chain (meeting -> destination). Linear in the path length
+// Returns: number of vertices on the path, 0 if destination was not reached
+size_t reconstructPath(int start, int destination, const BidirectionalWorkspace& workspace, vector<int>& path){
+  path.clear();
+  if(workspace.meeting == -1){
+    return 0;
+  }
+  
+  // Forward half, collected backwards from the meeting vertex then flipped
+  for(int current = workspace.meeting; current != start; current = workspace.forward.parent(current)){
+    path.push_back(current);
+  }
+  path.push_back(start);
+  reverse(path.begin(), path.end());
+  
+  // Backward half: backward parents already point towards destination
+  for(int current = workspace.meeting; current != destination; ){
+    current = workspace.backward.parent(current);
+    path.push_back(current);
+  }
+  return path.size();
+}
+
+// Precomputed landmark distances for goal-directed (ALT) search
+// For every landmark L and vertex v the table keeps d(L, v) and d(v, L).
+// By the triangle inequality, for any target t:
+//   d(v, t) >= d(L, t) - d(L, v)   and   d(v, t) >= d(v, L) - d(t, L)
+// so the largest of these over all landmarks is a lower bound on the
+// remaining distance that never overestimates. Distances are stored
+// vertex-major (the k entries of one vertex are adjacent), so one bound
+// reads two short contiguous runs
+class LandmarkTable{
+  public:
+    vector<int> landmarks;     // Chosen landmark vertex ids
+    vector<int> fromLandmark;  // fromLandmark[v * k + i] = d(landmarks[i], v)
+    vector<int> toLandmark;    // toLandmark[v * k + i]   = d(v, landmarks[i])
+    
+    // Picks k landmarks by farthest-point selection and fills both tables
+    // The first landmark is vertex 0; each next one is the vertex whose
+    // closest already-chosen landmark is farthest away, which spreads them
+    // over the edge of the graph where their bounds are tightest
+    // Vertices a landmark cannot reach are skipped when choosing
+    static LandmarkTable build(const CsrGraph& graph, const CsrGraph& reverseGraph, int k){
+      LandmarkTable table;
+      int n = graph.vertexCount();
+      k = min(k, n);
+      table.fromLandmark.assign((size_t)n * k, INT_MAX);
+      table.toLandmark.assign((size_t)n * k, INT_MAX);
+      
+      QueryWorkspace workspace(n);
+      vector<long long> closest(n, LLONG_MAX);  // Distance to nearest chosen landmark
+      int next = 0;
+      
+      for(int i = 0; i < k && next != -1; i++){
+        table.landmarks.push_back(next);
+        
+        // One-to-all searches: destination -1 is never settled
+        findShortestPath(graph, next, -1, workspace);
+        for(int v = 0; v < n; v++){
+          table.fromLandmark[(size_t)v * k + i] = workspace.distance(v);
+        }
+        findShortestPath(reverseGraph, next, -1, workspace);
+        for(int v = 0; v < n; v++){
+          table.toLandmark[(size_t)v * k + i] = workspace.distance(v);
+        }
+        
+        // Farthest reachable vertex from all landmarks so far becomes the next one
+        next = -1;
+        long long farthest = -1;
+        for(int v = 0; v < n; v++){
+          int d = table.fromLandmark[(size_t)v * k + i];
+          if(d != INT_MAX){
+            closest[v] = min(closest[v], (long long)d);
+          }
+          if(closest[v] != LLONG_MAX && closest[v] > farthest){
+            farthest = closest[v];
+            next = v;
+          }
+        }
+        if(farthest <= 0){
+          next = -1;  // Every reachable vertex already is a landmark
+        }
+      }
+      
+      // Drop unused columns if fewer than k landmarks were found
+      table.compact(n, k);
+      return table;
+    }
+    
+    int landmarkCount() const{
+      return (int)landmarks.size();
+    }
+    
+    // Lower bound on d(vertex, target); INT_MAX means target is provably
+    // unreachable from vertex (some landmark reaches vertex but not target,
+    // or target reaches a landmark that vertex cannot)
+    int lowerBound(int vertex, int target) const{
+      int k = landmarkCount();
+      const int* fromV = &fromLandmark[(size_t)vertex * k];
+      const int* fromT = &fromLandmark[(size_t)target * k];
+      const int* toV = &toLandmark[(size_t)vertex * k];
+      const int* toT = &toLandmark[(size_t)target * k];
+      
+      int bound = 0;
+      for(int i = 0; i < k; i++){
+        if(fromV[i] != INT_MAX){
+          if(fromT[i] == INT_MAX){
+            return INT_MAX;
+          }
+          bound = max(bound, fromT[i] - fromV[i]);
+        }
+        if(toT[i] != INT_MAX){
+          if(toV[i] == INT_MAX){
+            return INT_MAX;
+          }
+          bound = max(bound, toV[i] - toT[i]);
+        }
+      }
+      return bound;
+    }
+    
+  private:
+    // Re-packs the tables from stride k to the number of landmarks chosen
+    void compact(int n, int k){
+      int used = landmarkCount();
+      if(used == k){
+        return;
+      }
+      for(int v = 0; v < n; v++){
+        for(int i = 0; i < used; i++){
+          fromLandmark[(size_t)v * used + i] = fromLandmark[(size_t)v * k + i];
+          toLandmark[(size_t)v * used + i] = toLandmark[(size_t)v * k + i];
+        }
+      }
+      fromLandmark.resize((size_t)n * used);
+      toLandmark.resize((size_t)n * used);
+    }
+};
+
+// A* search with landmark lower bounds (ALT)
+// Like findShortestPath, but the heap is ordered by distance + lowerBound,
+// so vertices leading away from destination are popped late or never.
+// The bound is consistent, which keeps the result exact and lets each
+// vertex be settled once. Vertices proven unable to reach destination are
+// not queued at all. Distances and parents stay in the workspace as usual
+// Returns: distance from start to destination, INT_MAX if unreachable
+int findShortestPathAStar(const CsrGraph& graph, const LandmarkTable& landmarks,
+                          int start, int destination, QueryWorkspace& workspace){
+  workspace.reset();
+  int startBound = landmarks.lowerBound(start, destination);
+  if(startBound == INT_MAX){
+    return INT_MAX;
+  }
+  workspace.update(start, 0, -1);
+  workspace.push(startBound, start);
+  
+  while(!workspace.heapEmpty()){
+    int current = workspace.pop().second;
+    if(workspace.isSettled(current)){
+      continue;
+    }
+    workspace.settle(current);
+    int currentDistance = workspace.distance(current);
+    if(current == destination){
+      return currentDistance;
+    }
+    
+    for(int e = graph.offsets[current]; e < graph.offsets[current + 1]; e++){
+      int neighbor = graph.targets[e];
+      int newDistance = currentDistance + graph.weights[e];
+      if(workspace.isSettled(neighbor) || newDistance >= workspace.distance(neighbor)){
+        continue;
+      }
+      int bound = landmarks.lowerBound(neighbor, destination);
+      if(bound == INT_MAX){
+        continue;
+      }
+      workspace.update(neighbor, newDistance, current);
+      workspace.push(newDistance + bound, neighbor);
+    }
+  }
+  
+  return INT_MAX;
+}
+
+// Builds a road-like test graph: a side x side grid where every place is
+// connected to its right and lower neighbour in both directions
+// Edge weights are random in [1, 100], seeded so runs are repeatable
+vector<Place*> buildGridGraph(int side, unsigned seed){
+  mt19937 rng(seed);
+  uniform_int_distribution<int> weight(1, 100);
+  
+  vector<Place*> places;
+  places.reserve((size_t)side * side);
+  for(int i = 0; i < side * side; i++){
+    places.push_back(new Place(to_string(i)));
+  }
+  
+  for(int row = 0; row < side; row++){
+    for(int col = 0; col < side; col++){
+      Place* here = places[row * side + col];
+      if(col + 1 < side){
+        Place* right = places[row * side + col + 1];
+        int w = weight(rng);
+        here->addNeighbour(right, w);
+        right->addNeighbour(here, w);
+      }
+      if(row + 1 < side){
+        Place* down = places[(row + 1) * side + col];
+        int w = weight(rng);
+        here->addNeighbour(down, w);
+        down->addNeighbour(here, w);
+      }
+    }
+  }
+  return places;
+}
+
+// Times the heap-based findShortestPath (on Places, on the CSR graph, and
+// on the CSR graph with a reused QueryWorkspace, bidirectionally, and as
+// A* with landmark bounds)
+// against the linear-scan baseline on random queries over a grid graph
+// and checks that all of them give the same answer
+// Usage: ./map_navigation bench [side] [queries]
+void runBenchmark(int side, int queries){
+  vector<Place*> places = buildGridGraph(side, 42);
+  unordered_map<Place*, int> idOf;
+  CsrGraph graph = CsrGraph::fromPlaces(places, idOf);
+  mt19937 rng(7);
+  uniform_int_distribution<size_t> pick(0, places.size() - 1);
+  
+  CsrGraph reverseGraph = graph.reversed();
+  QueryWorkspace workspace(graph.vertexCount());
+  BidirectionalWorkspace bidirectional(graph.vertexCount());
+  QueryWorkspace aStarWorkspace(graph.vertexCount());
+  auto p0 = chrono::steady_clock::now();
+  LandmarkTable landmarks = LandmarkTable::build(graph, reverseGraph, 8);
+  double landmarkSeconds = chrono::duration<double>(chrono::steady_clock::now() - p0).count();
+  vector<int> pathBuffer;
+  double heapSeconds = 0, scanSeconds = 0, csrSeconds = 0, workspaceSeconds = 0, bidirectionalSeconds = 0, aStarSeconds = 0;
+  long long unidirectionalSettled = 0, bidirectionalSettled = 0, aStarSettled = 0;
+  int mismatches = 0;
+  
+  for(int q = 0; q < queries; q++){
+    Place* from = places[pick(rng)];
+    Place* to = places[pick(rng)];
+    
+    unordered_map<Place*, Place*> heapParent, scanParent;
+    
+    auto t0 = chrono::steady_clock::now();
+    unordered_map<Place*, int> heapDistances = findShortestPath(from, to, heapParent);
+    auto t1 = chrono::steady_clock::now();
+    unordered_map<Place*, int> scanDistances = findShortestPathLinearScan(from, to, scanParent);
+    auto t2 = chrono::steady_clock::now();
+    vector<int> csrParent;
+    vector<int> csrDistances = findShortestPath(graph, idOf[from], idOf[to], csrParent);
+    auto t3 = chrono::steady_clock::now();
+    int workspaceDistance = findShortestPath(graph, idOf[from], idOf[to], workspace);
+    reconstructPath(idOf[from], idOf[to], workspace, pathBuffer);
+    auto t4 = chrono::steady_clock::now();
+    int bidirectionalDistance = findShortestPathBidirectional(graph, reverseGraph, idOf[from], idOf[to], bidirectional);
+    reconstructPath(idOf[from], idOf[to], bidirectional, pathBuffer);
+    auto t5 = chrono::steady_clock::now();
+    int aStarDistance = findShortestPathAStar(graph, landmarks, idOf[from], idOf[to], aStarWorkspace);
+    reconstructPath(idOf[from], idOf[to], aStarWorkspace, pathBuffer);
+    auto t6 = chrono::steady_clock::now();
+    unidirectionalSettled += workspace.settled();
+    bidirectionalSettled += bidirectional.settled();
+    aStarSettled += aStarWorkspace.settled();
+    
+    heapSeconds += chrono::duration<double>(t1 - t0).count();
+    scanSeconds += chrono::duration<double>(t2 - t1).count();
+    csrSeconds += chrono::duration<double>(t3 - t2).count();
+    workspaceSeconds += chrono::duration<double>(t4 - t3).count();
+    bidirectionalSeconds += chrono::duration<double>(t5 - t4).count();
+    aStarSeconds += chrono::duration<double>(t6 - t5).count();
+    if(heapDistances[to] != scanDistances[to] || csrDistances[idOf[to]] != heapDistances[to]
+       || workspaceDistance != heapDistances[to] || bidirectionalDistance != heapDistances[to]
+       || aStarDistance != heapDistances[to]){
+      mismatches++;
+    }
+  }
+  
+  cout << "Grid " << side << "x" << side << ", " << queries << " queries" << endl;
+  cout << "  heap Dijkstra:        " << heapSeconds * 1000 / queries << " ms/query" << endl;
+  cout << "  linear-scan Dijkstra: " << scanSeconds * 1000 / queries << " ms/query" << endl;
+  cout << "  CSR heap Dijkstra:    " << csrSeconds * 1000 / queries << " ms/query" << endl;
+  cout << "  CSR + workspace:      " << workspaceSeconds * 1000 / queries << " ms/query (incl. path), "
+       << unidirectionalSettled / queries << " settled/query" << endl;
+  cout << "  bidirectional:        " << bidirectionalSeconds * 1000 / queries << " ms/query (incl. path), "
+       << bidirectionalSettled / queries << " settled/query" << endl;
+  cout << "  A* + " << landmarks.landmarkCount() << " landmarks:     " << aStarSeconds * 1000 / queries << " ms/query (incl. path), "
+       << aStarSettled / queries << " settled/query, " << landmarkSeconds * 1000 << " ms preprocessing" << endl;
+  cout << "  mismatching distances: " << mismatches << endl;
+  
+  for(Place* place : places){
+    delete place;
+  }
+}
+
 // Main function: demonstrates Dijkstra's algorithm
-int main(){
+int main(int argc, char* argv[]){
+  
+  // Optional benchmark mode
+  if(argc > 1 && string(argv[1]) == "bench"){
+    int side = argc > 2 ? stoi(argv[2]) : 100;
+    int queries = argc > 3 ? stoi(argv[3]) : 20;
+    runBenchmark(side, queries);
+    return 0;
+  }
   
   // Create 4 places (nodes in the graph)
   Place startingPoint("A");
@@ -165,5 +944,53 @@ int main(){
     cout << "No path found to destination." << endl;
   }
   
+  // Same query on the compact CSR form of the map
+  unordered_map<Place*, int> idOf;
+  CsrGraph compactMap = CsrGraph::fromPlaces({&startingPoint}, idOf);
+  vector<int> csrParent;
+  vector<int> csrDistances = findShortestPath(compactMap, idOf[&startingPoint], idOf[&endPoint], csrParent);
+  if(csrDistances[idOf[&endPoint]] != INT_MAX){
+    cout << "CSR shortest distance: " << csrDistances[idOf[&endPoint]] << endl;
+    cout << "CSR path:";
+    for(int vertex : reconstructPath(idOf[&startingPoint], idOf[&endPoint], csrParent)){
+      cout << " " << compactMap.getName(vertex);
+    }
+    cout << endl;
+  }
+  
+  // Repeated queries reuse one workspace and one path buffer
+  QueryWorkspace workspace(compactMap.vertexCount());
+  vector<int> route;
+  for(Place* target : {&midPointB, &midPointC, &endPoint}){
+    int distance = findShortestPath(compactMap, idOf[&startingPoint], idOf[target], workspace);
+    reconstructPath(idOf[&startingPoint], idOf[target], workspace, route);
+    cout << "A to " << target->getName() << ": " << distance << " via";
+    for(int vertex : route){
+      cout << " " << compactMap.getName(vertex);
+    }
+    cout << endl;
+  }
+  
+  // Point-to-point query searched from both ends at once
+  CsrGraph reverseMap = compactMap.reversed();
+  BidirectionalWorkspace bidirectional(compactMap.vertexCount());
+  int distance = findShortestPathBidirectional(compactMap, reverseMap, idOf[&startingPoint], idOf[&endPoint], bidirectional);
+  reconstructPath(idOf[&startingPoint], idOf[&endPoint], bidirectional, route);
+  cout << "Bidirectional A to D: " << distance << " via";
+  for(int vertex : route){
+    cout << " " << compactMap.getName(vertex);
+  }
+  cout << endl;
+  
+  // Goal-directed query using landmark lower bounds
+  LandmarkTable landmarks = LandmarkTable::build(compactMap, reverseMap, 2);
+  distance = findShortestPathAStar(compactMap, landmarks, idOf[&startingPoint], idOf[&endPoint], workspace);
+  reconstructPath(idOf[&startingPoint], idOf[&endPoint], workspace, route);
+  cout << "A* (landmarks) A to D: " << distance << " via";
+  for(int vertex : route){
+    cout << " " << compactMap.getName(vertex);
+  }
+  cout << endl;
+  
   return 0;
 }
\ No newline at end of file
@@ -0,0 +1,332 @@
+#include<iostream>
+#include<vector>
+#include<string>
+#include<algorithm>
+#include<numeric>
+#include<thread>
+#include<atomic>
+#include<cstdint>
+#include<chrono>
+#include<random>
+using namespace std;
+
+// Minimum spanning forest with parallel Borůvka
+//
+// Every round, each component picks its cheapest edge to another component
+// and all of those edges are added at once; the number of components at
+// least halves per round, so there are O(log V) rounds. Both steps run in
+// parallel:
+//   - edge scan: threads take chunks of the surviving edges and lower the
+//     per-component minimum with an atomic compare-and-swap on a packed
+//     (weight, edge index) key; edges inside a component are dropped
+//   - merge: every component root unites along its chosen edge in the
+//     lock-free union-find from connected_components.cpp; the unite that
+//     actually links two sets records the edge
+// Ties are broken by edge index, so all edges compare distinct and the
+// chosen edges can never close a cycle. Edges are undirected here.
+// Kruskal with a sequential union-find is the reference.
+
+// A single weighted edge between two vertex ids (undirected for the MST)
+struct Edge{
+  int from;
+  int to;
+  int weight;
+};
+
+// Result of one MST computation
+struct SpanningForest{
+  vector<Edge> edges;    // V - components edges
+  long long totalWeight;
+};
+
+// Sequential union-find with union by rank and path compression
+class UnionFind{
+  public:
+    explicit UnionFind(int vertexCount) : parent(vertexCount), rank(vertexCount, 0){
+      iota(parent.begin(), parent.end(), 0);
+    }
+
+    int find(int vertex){
+      int root = vertex;
+      while(parent[root] != root){
+        root = parent[root];
+      }
+      while(parent[vertex] != root){
+        int next = parent[vertex];
+        parent[vertex] = root;
+        vertex = next;
+      }
+      return root;
+    }
+
+    // Returns false if a and b were already in the same set
+    bool unite(int a, int b){
+      a = find(a);
+      b = find(b);
+      if(a == b){
+        return false;
+      }
+      if(rank[a] < rank[b]){
+        swap(a, b);
+      }
+      parent[b] = a;
+      rank[a] += rank[a] == rank[b];
+      return true;
+    }
+
+  private:
+    vector<int> parent;
+    vector<unsigned char> rank;
+};
+
+// Lock-free union-find (as in connected_components.cpp)
+class ConcurrentUnionFind{
+  public:
+    explicit ConcurrentUnionFind(int vertexCount) : parent(vertexCount){
+      for(int v = 0; v < vertexCount; v++){
+        parent[v].store(v, memory_order_relaxed);
+      }
+    }
+
+    // Path halving: every visited vertex is pointed at its grandparent
+    int find(int vertex){
+      for(;;){
+        int up = parent[vertex].load(memory_order_relaxed);
+        if(up == vertex){
+          return vertex;
+        }
+        int grand = parent[up].load(memory_order_relaxed);
+        if(grand != up){
+          parent[vertex].compare_exchange_weak(up, grand, memory_order_relaxed);
+        }
+        vertex = grand;
+      }
+    }
+
+    // Links the larger root under the smaller one; returns false if a and
+    // b were already in the same set
+    bool unite(int a, int b){
+      for(;;){
+        a = find(a);
+        b = find(b);
+        if(a == b){
+          return false;
+        }
+        if(a < b){
+          swap(a, b);
+        }
+        int expected = a;
+        if(parent[a].compare_exchange_strong(expected, b, memory_order_relaxed)){
+          return true;
+        }
+      }
+    }
+
+  private:
+    vector<atomic<int> > parent;
+};
+
+// Calls body(thread, i) for i in [0, count), handed out in chunks to threadCount threads
+template<typename Body>
+static void runParallel(int threadCount, size_t count, const Body& body){
+  const size_t chunk = 4096;
+  atomic<size_t> next(0);
+  auto worker = [&](int thread){
+    for(size_t begin = next.fetch_add(chunk); begin < count; begin = next.fetch_add(chunk)){
+      size_t end = min(count, begin + chunk);
+      for(size_t i = begin; i < end; i++){
+        body(thread, i);
+      }
+    }
+  };
+  vector<std::thread> threads;
+  for(int t = 1; t < threadCount; t++){
+    threads.push_back(std::thread(worker, t));
+  }
+  worker(0);
+  for(std::thread& t : threads){
+    t.join();
+  }
+}
+
+// Lowers slot to key if key is smaller
+static void atomicMin(atomic<uint64_t>& slot, uint64_t key){
+  uint64_t current = slot.load(memory_order_relaxed);
+  while(key < current && !slot.compare_exchange_weak(current, key, memory_order_relaxed)){
+  }
+}
+
+// Minimum spanning forest with threadCount threads
+SpanningForest boruvka(int vertexCount, const vector<Edge>& edges, int threadCount){
+  threadCount = max(1, threadCount);
+  const uint64_t none = UINT64_MAX;
+  ConcurrentUnionFind sets(vertexCount);
+  vector<atomic<uint64_t> > cheapest(vertexCount);
+  runParallel(threadCount, vertexCount, [&](int, size_t v){
+    cheapest[v].store(none, memory_order_relaxed);
+  });
+
+  // Surviving edge indices, rebuilt from per-thread lists every round
+  vector<uint32_t> alive(edges.size());
+  iota(alive.begin(), alive.end(), 0);
+  vector<vector<uint32_t> > keep(threadCount);
+  vector<vector<uint32_t> > chosen(threadCount);
+  vector<int> roots;
+
+  while(!alive.empty()){
+    // Edge scan: cheapest outgoing edge per component; the key orders by
+    // weight (sign bit flipped so negative weights sort first), then index
+    for(vector<uint32_t>& list : keep){
+      list.clear();
+    }
+    runParallel(threadCount, alive.size(), [&](int thread, size_t i){
+      uint32_t index = alive[i];
+      const Edge& edge = edges[index];
+      int a = sets.find(edge.from), b = sets.find(edge.to);
+      if(a == b){
+        return;
+      }
+      uint64_t key = (uint64_t)((uint32_t)edge.weight ^ 0x80000000u) << 32 | index;
+      atomicMin(cheapest[a], key);
+      atomicMin(cheapest[b], key);
+      keep[thread].push_back(index);
+    });
+    alive.clear();
+    for(const vector<uint32_t>& list : keep){
+      alive.insert(alive.end(), list.begin(), list.end());
+    }
+    if(alive.empty()){
+      break;
+    }
+
+    // Components that picked an edge: every endpoint root of a surviving edge
+    roots.clear();
+    for(int v = 0; v < vertexCount; v++){
+      if(cheapest[v].load(memory_order_relaxed) != none){
+        roots.push_back(v);
+      }
+    }
+
+    // Merge along the chosen edges and reset the minima for the next round
+    runParallel(threadCount, roots.size(), [&](int thread, size_t i){
+      int root = roots[i];
+      uint32_t index = (uint32_t)cheapest[root].load(memory_order_relaxed);
+      if(sets.unite(edges[index].from, edges[index].to)){
+        chosen[thread].push_back(index);
+      }
+    });
+    runParallel(threadCount, roots.size(), [&](int, size_t i){
+      cheapest[roots[i]].store(none, memory_order_relaxed);
+    });
+  }
+
+  SpanningForest forest;
+  forest.totalWeight = 0;
+  for(const vector<uint32_t>& list : chosen){
+    for(uint32_t index : list){
+      forest.edges.push_back(edges[index]);
+      forest.totalWeight += edges[index].weight;
+    }
+  }
+  return forest;
+}
+
+// Sequential Kruskal reference: edges by weight, skipping those inside a set
+SpanningForest kruskal(int vertexCount, const vector<Edge>& edges){
+  vector<uint32_t> order(edges.size());
+  iota(order.begin(), order.end(), 0);
+  sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b){
+    return edges[a].weight != edges[b].weight ? edges[a].weight < edges[b].weight : a < b;
+  });
+  UnionFind sets(vertexCount);
+  SpanningForest forest;
+  forest.totalWeight = 0;
+  for(uint32_t index : order){
+    if(sets.unite(edges[index].from, edges[index].to)){
+      forest.edges.push_back(edges[index]);
+      forest.totalWeight += edges[index].weight;
+    }
+  }
+  return forest;
+}
+
+// Road-like side x side grid with random weights in [1, 100], one edge per road
+vector<Edge> buildGridEdges(int side, unsigned seed){
+  mt19937 rng(seed);
+  uniform_int_distribution<int> weight(1, 100);
+  vector<Edge> edges;
+  for(int row = 0; row < side; row++){
+    for(int col = 0; col < side; col++){
+      int here = row * side + col;
+      if(col + 1 < side){
+        edges.push_back({here, here + 1, weight(rng)});
+      }
+      if(row + 1 < side){
+        edges.push_back({here, here + side, weight(rng)});
+      }
+    }
+  }
+  return edges;
+}
+
+// Uniform random graph with weights in [1, 1000000]
+vector<Edge> buildRandomEdges(int vertexCount, int edgeCount, unsigned seed){
+  mt19937 rng(seed);
+  uniform_int_distribution<int> vertex(0, vertexCount - 1);
+  uniform_int_distribution<int> weight(1, 1000000);
+  vector<Edge> edges(edgeCount);
+  for(Edge& edge : edges){
+    edge = {vertex(rng), vertex(rng), weight(rng)};
+  }
+  return edges;
+}
+
+// Times Kruskal and Borůvka for 1, 2, 4, ... threads up to the core count;
+// every forest must match Kruskal's edge count and total weight
+void speedupCurve(const string& label, int vertexCount, const vector<Edge>& edges){
+  auto t0 = chrono::steady_clock::now();
+  SpanningForest expected = kruskal(vertexCount, edges);
+  double kruskalSeconds = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+  cout << label << ": " << vertexCount << " vertices, " << edges.size() << " edges, forest weight "
+       << expected.totalWeight << endl;
+  cout << "  Kruskal: " << kruskalSeconds * 1000 << " ms" << endl;
+
+  int cores = max(1, (int)thread::hardware_concurrency());
+  for(int threads = 1; ; threads = min(threads * 2, cores)){
+    auto t1 = chrono::steady_clock::now();
+    SpanningForest forest = boruvka(vertexCount, edges, threads);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - t1).count();
+    bool same = forest.totalWeight == expected.totalWeight && forest.edges.size() == expected.edges.size();
+    cout << "  Boruvka, " << threads << " threads: " << seconds * 1000 << " ms, speedup vs Kruskal "
+         << kruskalSeconds / seconds << (same ? "" : " (MISMATCH)") << endl;
+    if(threads == cores){
+      break;
+    }
+  }
+}
+
+// Usage: ./minimum_spanning_tree bench [side]
+//   road graph: side x side grid, random graph: same vertex count, 5 edges per vertex
+int main(int argc, char* argv[]){
+
+  if(argc > 1 && string(argv[1]) == "bench"){
+    int side = argc > 2 ? stoi(argv[2]) : 1000;
+    int n = side * side;
+    speedupCurve("Road grid", n, buildGridEdges(side, 42));
+    speedupCurve("Random graph", n, buildRandomEdges(n, 5 * n, 42));
+    return 0;
+  }
+
+  // Graph structure (ids: A=0, B=1, C=2, D=3), roads usable both ways:
+  //   A --10-- B --15-- D
+  //    \              /
+  //     5---- C --20--
+  vector<string> names = {"A", "B", "C", "D"};
+  vector<Edge> edges = {{0, 1, 10}, {0, 2, 5}, {1, 3, 15}, {2, 3, 20}};
+  SpanningForest forest = boruvka(4, edges, 2);
+  cout << "Minimum spanning tree (weight " << forest.totalWeight << "):" << endl;
+  for(const Edge& edge : forest.edges){
+    cout << "  " << names[edge.from] << " - " << names[edge.to] << " (" << edge.weight << ")" << endl;
+  }
+  return 0;
+}
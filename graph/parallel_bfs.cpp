@@ -0,0 +1,445 @@
+#include<iostream>
+#include<vector>
+#include<string>
+#include<algorithm>
+#include<queue>
+#include<thread>
+#include<mutex>
+#include<condition_variable>
+#include<atomic>
+#include<climits>
+#include<cstdint>
+#include<cmath>
+#include<chrono>
+#include<random>
+using namespace std;
+
+// Parallel direction-optimizing breadth-first search
+//
+// For hop counts and reachability the edge weights do not matter, so a
+// level-synchronous BFS replaces Dijkstra. Each level is expanded in one of
+// two directions:
+//   - top-down: every frontier vertex claims its unvisited out-neighbours
+//   - bottom-up: every unvisited vertex looks through its in-neighbours for
+//     one in the frontier and stops at the first hit
+// Top-down is cheap while the frontier is small; once the frontier's edges
+// outnumber the unvisited edges / alpha, bottom-up checks far fewer edges.
+// The search switches back when the frontier shrinks below V / beta.
+//
+// The visited set is a bitmap with one bit per vertex. Bottom-up levels
+// read the frontier as a bitmap too; top-down levels read it as a vertex
+// list, so a small frontier on a long road graph does not cost a scan of
+// V / 64 words per level. The frontier is converted when the direction
+// changes. Each level is split into chunks that threads take from a shared
+// counter; top-down claims vertices with an atomic fetch_or, while
+// bottom-up chunks own their bitmap words outright.
+
+// A single directed, weighted edge between two vertex ids (weights unused)
+struct Edge{
+  int from;
+  int to;
+  int weight;
+};
+
+// Unweighted CSR graph with both out-edges (top-down) and in-edges (bottom-up)
+class BfsGraph{
+  public:
+    vector<int> outOffsets;  // Size V + 1
+    vector<int> outTargets;  // Size E
+    vector<int> inOffsets;   // Size V + 1
+    vector<int> inSources;   // Size E
+
+    BfsGraph(int vertexCount, const vector<Edge>& edges)
+      : outOffsets(vertexCount + 1, 0), outTargets(edges.size()), inOffsets(vertexCount + 1, 0), inSources(edges.size()){
+      for(const Edge& edge : edges){
+        outOffsets[edge.from + 1]++;
+        inOffsets[edge.to + 1]++;
+      }
+      for(int v = 0; v < vertexCount; v++){
+        outOffsets[v + 1] += outOffsets[v];
+        inOffsets[v + 1] += inOffsets[v];
+      }
+      vector<int> nextOut(outOffsets.begin(), outOffsets.end() - 1);
+      vector<int> nextIn(inOffsets.begin(), inOffsets.end() - 1);
+      for(const Edge& edge : edges){
+        outTargets[nextOut[edge.from]++] = edge.to;
+        inSources[nextIn[edge.to]++] = edge.from;
+      }
+    }
+
+    int vertexCount() const{
+      return (int)outOffsets.size() - 1;
+    }
+
+    long long edgeCount() const{
+      return (long long)outTargets.size();
+    }
+
+    int outDegree(int vertex) const{
+      return outOffsets[vertex + 1] - outOffsets[vertex];
+    }
+};
+
+// Reusable barrier for a fixed number of threads (as in delta_stepping.cpp)
+class Barrier{
+  public:
+    explicit Barrier(int threadCount) : threadCount(threadCount), waiting(0), generation(0){}
+
+    void wait(){
+      unique_lock<mutex> lock(m);
+      unsigned arrived = generation;
+      if(++waiting == threadCount){
+        waiting = 0;
+        generation++;
+        released.notify_all();
+        return;
+      }
+      released.wait(lock, [this, arrived](){ return generation != arrived; });
+    }
+
+  private:
+    mutex m;
+    condition_variable released;
+    int threadCount;
+    int waiting;
+    unsigned generation;
+};
+
+// Result of one search
+struct BfsResult{
+  vector<int> hops;             // Hop count from the nearest source, -1 if unreachable
+  long long edgesInComponent;   // Out-edges of all reached vertices (the TEPS numerator)
+  int levels;
+  int bottomUpLevels;
+};
+
+// Hop counts from every source at once, with threadCount threads
+// alpha and beta are the direction-switching thresholds described above
+BfsResult parallelBfs(const BfsGraph& graph, const vector<int>& sources, int threadCount,
+                      int alpha = 15, int beta = 18){
+  int n = graph.vertexCount();
+  size_t words = ((size_t)n + 63) / 64;
+  threadCount = max(1, threadCount);
+
+  BfsResult result;
+  result.hops.assign(n, -1);
+  result.edgesInComponent = 0;
+  result.levels = 0;
+  result.bottomUpLevels = 0;
+
+  vector<atomic<uint64_t> > visited(words), current(words), next(words);
+  for(size_t w = 0; w < words; w++){
+    visited[w].store(0, memory_order_relaxed);
+    current[w].store(0, memory_order_relaxed);
+    next[w].store(0, memory_order_relaxed);
+  }
+  vector<int> frontier;
+  long long frontierEdges = 0;
+  for(int source : sources){
+    uint64_t bit = 1ull << (source % 64);
+    if(!(visited[source / 64].fetch_or(bit, memory_order_relaxed) & bit)){
+      frontier.push_back(source);
+      result.hops[source] = 0;
+      frontierEdges += graph.outDegree(source);
+    }
+  }
+
+  // Shared level state, written by thread 0 between the two barriers
+  long long frontierSize = (long long)frontier.size();
+  long long unexploredEdges = graph.edgeCount() - frontierEdges;
+  long long reachedEdges = frontierEdges;
+  bool bottomUp = false;
+  bool done = frontierSize == 0;
+  int level = 0;
+  atomic<size_t> nextChunk(0);
+  atomic<long long> nextSize(0), nextEdges(0);
+  vector<vector<int> > discovered(threadCount);  // Per-thread top-down output
+  const size_t chunkVertices = 256;              // Top-down: frontier entries per chunk
+  const size_t chunkWords = 64;                  // Bottom-up: 4096 vertices per chunk
+  Barrier barrier(threadCount);
+
+  auto worker = [&](int thread){
+    vector<int>& mine = discovered[thread];
+    while(!done){
+      long long mySize = 0, myEdges = 0;
+      if(bottomUp){
+        for(size_t chunk = nextChunk++; chunk * chunkWords < words; chunk = nextChunk++){
+          size_t end = min(words, (chunk + 1) * chunkWords);
+          for(size_t w = chunk * chunkWords; w < end; w++){
+            // This thread owns word w: scan its unvisited vertices
+            uint64_t unvisited = ~visited[w].load(memory_order_relaxed);
+            if(w == words - 1 && n % 64 != 0){
+              unvisited &= (1ull << (n % 64)) - 1;
+            }
+            uint64_t found = 0;
+            while(unvisited){
+              int bit = __builtin_ctzll(unvisited);
+              unvisited &= unvisited - 1;
+              int v = (int)(w * 64 + bit);
+              for(int e = graph.inOffsets[v]; e < graph.inOffsets[v + 1]; e++){
+                int u = graph.inSources[e];
+                if(current[u / 64].load(memory_order_relaxed) & (1ull << (u % 64))){
+                  found |= 1ull << bit;
+                  result.hops[v] = level + 1;
+                  mySize++;
+                  myEdges += graph.outDegree(v);
+                  break;
+                }
+              }
+            }
+            if(found){
+              visited[w].fetch_or(found, memory_order_relaxed);
+              next[w].store(found, memory_order_relaxed);
+            }
+          }
+        }
+      }
+      else{
+        // Expand each frontier vertex, claiming targets atomically
+        mine.clear();
+        for(size_t chunk = nextChunk++; chunk * chunkVertices < frontier.size(); chunk = nextChunk++){
+          size_t end = min(frontier.size(), (chunk + 1) * chunkVertices);
+          for(size_t i = chunk * chunkVertices; i < end; i++){
+            int u = frontier[i];
+            for(int e = graph.outOffsets[u]; e < graph.outOffsets[u + 1]; e++){
+              int v = graph.outTargets[e];
+              uint64_t bit = 1ull << (v % 64);
+              if(visited[v / 64].load(memory_order_relaxed) & bit){
+                continue;
+              }
+              if(!(visited[v / 64].fetch_or(bit, memory_order_relaxed) & bit)){
+                result.hops[v] = level + 1;
+                mine.push_back(v);
+                myEdges += graph.outDegree(v);
+              }
+            }
+          }
+        }
+        mySize = (long long)mine.size();
+      }
+      nextSize += mySize;
+      nextEdges += myEdges;
+      barrier.wait();
+
+      if(thread == 0){
+        // Advance to the next level and pick its direction
+        result.levels++;
+        result.bottomUpLevels += bottomUp;
+        frontierSize = nextSize.exchange(0);
+        frontierEdges = nextEdges.exchange(0);
+        unexploredEdges -= frontierEdges;
+        reachedEdges += frontierEdges;
+        bool wasBottomUp = bottomUp;
+        if(!bottomUp && frontierEdges > unexploredEdges / alpha){
+          bottomUp = true;
+        }
+        else if(bottomUp && frontierSize < n / beta){
+          bottomUp = false;
+        }
+
+        // The new frontier is in next (bottom-up) or the per-thread lists
+        // (top-down); convert it to the form the next level reads
+        if(wasBottomUp){
+          for(size_t w = 0; w < words; w++){
+            current[w].store(next[w].load(memory_order_relaxed), memory_order_relaxed);
+            next[w].store(0, memory_order_relaxed);
+          }
+          if(!bottomUp){
+            frontier.clear();
+            for(size_t w = 0; w < words; w++){
+              for(uint64_t bits = current[w].load(memory_order_relaxed); bits; bits &= bits - 1){
+                frontier.push_back((int)(w * 64 + __builtin_ctzll(bits)));
+              }
+            }
+          }
+        }
+        else{
+          frontier.clear();
+          for(const vector<int>& list : discovered){
+            frontier.insert(frontier.end(), list.begin(), list.end());
+          }
+          if(bottomUp){
+            for(size_t w = 0; w < words; w++){
+              current[w].store(0, memory_order_relaxed);
+            }
+            for(int v : frontier){
+              current[v / 64].fetch_or(1ull << (v % 64), memory_order_relaxed);
+            }
+          }
+        }
+        level++;
+        nextChunk = 0;
+        done = frontierSize == 0;
+      }
+      barrier.wait();
+    }
+  };
+
+  vector<thread> threads;
+  for(int t = 1; t < threadCount; t++){
+    threads.push_back(thread(worker, t));
+  }
+  worker(0);
+  for(thread& t : threads){
+    t.join();
+  }
+  result.edgesInComponent = reachedEdges;
+  return result;
+}
+
+// Sequential queue-based BFS reference
+vector<int> sequentialBfs(const BfsGraph& graph, const vector<int>& sources){
+  vector<int> hops(graph.vertexCount(), -1);
+  vector<int> queue;
+  for(int source : sources){
+    if(hops[source] == -1){
+      hops[source] = 0;
+      queue.push_back(source);
+    }
+  }
+  for(size_t i = 0; i < queue.size(); i++){
+    int u = queue[i];
+    for(int e = graph.outOffsets[u]; e < graph.outOffsets[u + 1]; e++){
+      int v = graph.outTargets[e];
+      if(hops[v] == -1){
+        hops[v] = hops[u] + 1;
+        queue.push_back(v);
+      }
+    }
+  }
+  return hops;
+}
+
+// Weighted Dijkstra on the same edges, for the TEPS comparison
+vector<int> dijkstra(int vertexCount, const vector<int>& offsets, const vector<int>& targets,
+                     const vector<int>& weights, int source){
+  vector<int> distances(vertexCount, INT_MAX);
+  typedef pair<int, int> HeapEntry;
+  priority_queue<HeapEntry, vector<HeapEntry>, greater<HeapEntry> > frontier;
+  distances[source] = 0;
+  frontier.push(HeapEntry(0, source));
+  while(!frontier.empty()){
+    HeapEntry top = frontier.top();
+    frontier.pop();
+    if(top.first > distances[top.second]){
+      continue;
+    }
+    for(int e = offsets[top.second]; e < offsets[top.second + 1]; e++){
+      int newDistance = top.first + weights[e];
+      if(newDistance < distances[targets[e]]){
+        distances[targets[e]] = newDistance;
+        frontier.push(HeapEntry(newDistance, targets[e]));
+      }
+    }
+  }
+  return distances;
+}
+
+// Road-like side x side grid with random weights in [1, 100] in both directions
+vector<Edge> buildGridEdges(int side, unsigned seed){
+  mt19937 rng(seed);
+  uniform_int_distribution<int> weight(1, 100);
+  vector<Edge> edges;
+  for(int row = 0; row < side; row++){
+    for(int col = 0; col < side; col++){
+      int here = row * side + col;
+      if(col + 1 < side){
+        int w = weight(rng);
+        edges.push_back({here, here + 1, w});
+        edges.push_back({here + 1, here, w});
+      }
+      if(row + 1 < side){
+        int w = weight(rng);
+        edges.push_back({here, here + side, w});
+        edges.push_back({here + side, here, w});
+      }
+    }
+  }
+  return edges;
+}
+
+// Uniform random directed graph with weights in [1, 100]
+vector<Edge> buildRandomEdges(int vertexCount, int edgeCount, unsigned seed){
+  mt19937 rng(seed);
+  uniform_int_distribution<int> vertex(0, vertexCount - 1);
+  uniform_int_distribution<int> weight(1, 100);
+  vector<Edge> edges(edgeCount);
+  for(Edge& edge : edges){
+    edge = {vertex(rng), vertex(rng), weight(rng)};
+  }
+  return edges;
+}
+
+// Times Dijkstra, sequential BFS and the parallel BFS for 1, 2, 4, ...
+// threads up to the core count, reporting traversed edges per second
+void tepsCurve(const string& label, int vertexCount, const vector<Edge>& edges){
+  BfsGraph graph(vertexCount, edges);
+  vector<int> sources(1, 0);
+
+  // Weighted CSR in the same edge order for Dijkstra
+  vector<int> weights(edges.size());
+  vector<int> next(graph.outOffsets.begin(), graph.outOffsets.end() - 1);
+  for(const Edge& edge : edges){
+    weights[next[edge.from]++] = edge.weight;
+  }
+
+  auto t0 = chrono::steady_clock::now();
+  dijkstra(vertexCount, graph.outOffsets, graph.outTargets, weights, 0);
+  double dijkstraSeconds = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+  auto t1 = chrono::steady_clock::now();
+  vector<int> expected = sequentialBfs(graph, sources);
+  double sequentialSeconds = chrono::duration<double>(chrono::steady_clock::now() - t1).count();
+
+  BfsResult reference = parallelBfs(graph, sources, 1);
+  double edgesInComponent = (double)reference.edgesInComponent;
+  cout << label << ": " << vertexCount << " vertices, " << edges.size() << " edges, "
+       << reference.levels << " levels (" << reference.bottomUpLevels << " bottom-up)" << endl;
+  cout << "  Dijkstra: " << dijkstraSeconds * 1000 << " ms, " << edgesInComponent / dijkstraSeconds / 1e6 << " MTEPS" << endl;
+  cout << "  sequential BFS: " << sequentialSeconds * 1000 << " ms, " << edgesInComponent / sequentialSeconds / 1e6
+       << " MTEPS" << endl;
+
+  int cores = max(1, (int)thread::hardware_concurrency());
+  for(int threads = 1; ; threads = min(threads * 2, cores)){
+    auto t2 = chrono::steady_clock::now();
+    BfsResult result = parallelBfs(graph, sources, threads);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - t2).count();
+    cout << "  " << threads << " threads: " << seconds * 1000 << " ms, " << edgesInComponent / seconds / 1e6
+         << " MTEPS" << (result.hops == expected ? "" : " (MISMATCH)") << endl;
+    if(threads == cores){
+      break;
+    }
+  }
+}
+
+// Usage: ./parallel_bfs bench [vertices]
+//   road graph: square grid with about that many vertices, random graph: 8 edges per vertex
+int main(int argc, char* argv[]){
+
+  if(argc > 1 && string(argv[1]) == "bench"){
+    int n = argc > 2 ? stoi(argv[2]) : 1000000;
+    int side = max(2, (int)sqrt((double)n));
+    tepsCurve("Road grid", side * side, buildGridEdges(side, 42));
+    tepsCurve("Random graph", n, buildRandomEdges(n, 8 * n, 42));
+    return 0;
+  }
+
+  // Graph structure (ids: A=0, B=1, C=2, D=3, E=4):
+  //   A --10--> B --15--> D     E (no roads)
+  //    \                 /
+  //     5----> C --20---
+  vector<string> names = {"A", "B", "C", "D", "E"};
+  BfsGraph graph(5, {{0, 1, 10}, {0, 2, 5}, {1, 3, 15}, {2, 3, 20}});
+
+  // Two sources at once: hops to the nearer of A and C
+  BfsResult result = parallelBfs(graph, {0, 2}, 2);
+  for(int v = 0; v < graph.vertexCount(); v++){
+    cout << "Hops from {A, C} to " << names[v] << ": ";
+    if(result.hops[v] == -1){
+      cout << "unreachable" << endl;
+    }
+    else{
+      cout << result.hops[v] << endl;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,426 @@
+#include<iostream>
+#include<fstream>
+#include<vector>
+#include<string>
+#include<string_view>
+#include<algorithm>
+#include<numeric>
+#include<queue>
+#include<cstdint>
+#include<cstdio>
+#include<chrono>
+#include<random>
+using namespace std;
+
+// Prefix autocomplete over place names
+//
+// A compressed radix trie: every edge carries a label of one or more bytes,
+// and a node exists only where names branch or end. The nodes are stored as
+// parallel arrays indexed by node id (no pointers), the children of a node
+// occupy a contiguous id range, and all labels live in one byte buffer.
+//
+// Each node also records the best score found anywhere in its subtree. A
+// top-k query walks down to the node covering the prefix, then expands
+// nodes best-first from a small heap, so it touches O(k * depth) nodes no
+// matter how many names share the prefix.
+
+// All place names in one contiguous buffer, indexed by vertex id
+// (same layout as NameArena in place_name_index.cpp)
+class NameArena{
+  public:
+    NameArena() : offsets(1, 0){}
+
+    // Appends a name and returns its vertex id
+    int add(string_view name){
+      bytes.insert(bytes.end(), name.begin(), name.end());
+      offsets.push_back((uint32_t)bytes.size());
+      return (int)offsets.size() - 2;
+    }
+
+    string_view name(int vertex) const{
+      return string_view(bytes.data() + offsets[vertex], offsets[vertex + 1] - offsets[vertex]);
+    }
+
+    int size() const{
+      return (int)offsets.size() - 1;
+    }
+
+  private:
+    vector<char> bytes;
+    vector<uint32_t> offsets;  // Size V + 1
+};
+
+// One autocomplete suggestion
+struct Suggestion{
+  int vertex;
+  int score;
+};
+
+// Static radix trie over place names with scored top-k prefix search
+class PlaceAutocomplete{
+  public:
+    PlaceAutocomplete(){}
+
+    // Builds the trie over every name in the arena; scores[v] ranks vertex v
+    // (higher first). When several vertices share a name only the best
+    // scored one is kept
+    PlaceAutocomplete(const NameArena& arena, const vector<int>& scores){
+      vector<int> sorted(arena.size());
+      iota(sorted.begin(), sorted.end(), 0);
+      sort(sorted.begin(), sorted.end(), [&](int a, int b){
+        int order = arena.name(a).compare(arena.name(b));
+        return order != 0 ? order < 0 : scores[a] > scores[b];
+      });
+      sorted.erase(unique(sorted.begin(), sorted.end(), [&](int a, int b){
+        return arena.name(a) == arena.name(b);
+      }), sorted.end());
+
+      addNodes(1);
+      if(!sorted.empty()){
+        buildNode(0, arena, scores, sorted, 0, sorted.size(), 0);
+      }
+    }
+
+    // Up to k names starting with prefix, best score first
+    vector<Suggestion> topK(string_view prefix, int k) const{
+      vector<Suggestion> results;
+      int node = findPrefixNode(prefix);
+      if(node == -1 || k <= 0){
+        return results;
+      }
+
+      // Entries are (score, node); a negative node -(n + 1) stands for the
+      // name ending at node n, a non-negative one for the subtree below it
+      typedef pair<int, int> Entry;
+      priority_queue<Entry> frontier;
+      frontier.push(Entry(bestScore[node], node));
+      while(!frontier.empty() && (int)results.size() < k){
+        Entry top = frontier.top();
+        frontier.pop();
+        if(top.second < 0){
+          results.push_back({vertex[-top.second - 1], top.first});
+          continue;
+        }
+        int current = top.second;
+        if(vertex[current] != -1){
+          frontier.push(Entry(terminalScore[current], -current - 1));
+        }
+        for(uint32_t child = childBegin[current]; child < childBegin[current] + childCount[current]; child++){
+          frontier.push(Entry(bestScore[child], (int)child));
+        }
+      }
+      return results;
+    }
+
+    size_t nodeCount() const{
+      return vertex.size();
+    }
+
+    size_t memoryBytes() const{
+      return labels.capacity() + labelStart.capacity() * sizeof(uint32_t) + labelLength.capacity() * sizeof(uint16_t)
+             + childBegin.capacity() * sizeof(uint32_t) + childCount.capacity() * sizeof(uint16_t)
+             + firstByte.capacity() + (vertex.capacity() + bestScore.capacity() + terminalScore.capacity()) * sizeof(int);
+    }
+
+    // Writes the trie to a versioned binary file, next to the graph file.
+    // Returns false if the file cannot be written
+    bool save(const string& path) const{
+      ofstream out(path, ios::binary);
+      if(!out){
+        return false;
+      }
+      uint32_t header[2] = {fileMagic, fileVersion};
+      out.write((const char*)header, sizeof(header));
+      writeArray(out, labels);
+      writeArray(out, labelStart);
+      writeArray(out, labelLength);
+      writeArray(out, childBegin);
+      writeArray(out, childCount);
+      writeArray(out, firstByte);
+      writeArray(out, vertex);
+      writeArray(out, bestScore);
+      writeArray(out, terminalScore);
+      return (bool)out;
+    }
+
+    // Reads a trie written by save(). Returns false (leaving this object
+    // unspecified) if the file is missing, from another version, truncated,
+    // or its arrays do not fit together
+    bool load(const string& path){
+      ifstream in(path, ios::binary);
+      if(!in){
+        return false;
+      }
+      uint32_t header[2];
+      if(!in.read((char*)header, sizeof(header)) || header[0] != fileMagic || header[1] != fileVersion){
+        return false;
+      }
+      if(!readArray(in, labels) || !readArray(in, labelStart) || !readArray(in, labelLength)
+         || !readArray(in, childBegin) || !readArray(in, childCount) || !readArray(in, firstByte)
+         || !readArray(in, vertex) || !readArray(in, bestScore) || !readArray(in, terminalScore)){
+        return false;
+      }
+      return isConsistent();
+    }
+
+  private:
+    static const uint32_t fileMagic = 0x31434150;  // "PAC1"
+    static const uint32_t fileVersion = 1;
+
+    // Per-node arrays, node 0 is the root
+    vector<char> labels;               // All edge labels back to back
+    vector<uint32_t> labelStart;       // Label of the edge into the node
+    vector<uint16_t> labelLength;
+    vector<uint32_t> childBegin;       // Children are ids [childBegin, childBegin + childCount)
+    vector<uint16_t> childCount;
+    vector<unsigned char> firstByte;   // First label byte, scanned when descending
+    vector<int> vertex;                // Vertex whose name ends here, -1 if none
+    vector<int> bestScore;             // Max score in the subtree
+    vector<int> terminalScore;         // Score of vertex, if any
+
+    void addNodes(size_t count){
+      size_t size = vertex.size() + count;
+      labelStart.resize(size, 0);
+      labelLength.resize(size, 0);
+      childBegin.resize(size, 0);
+      childCount.resize(size, 0);
+      firstByte.resize(size, 0);
+      vertex.resize(size, -1);
+      bestScore.resize(size, INT32_MIN);
+      terminalScore.resize(size, INT32_MIN);
+    }
+
+    // Fills node from the sorted names [begin, end), which all share their
+    // first depth bytes. The node's label runs from depth to the longest
+    // common prefix of the range; its children get one contiguous id block
+    void buildNode(int node, const NameArena& arena, const vector<int>& scores,
+                   const vector<int>& sorted, size_t begin, size_t end, size_t depth){
+      // The longest common prefix of a sorted range is that of its ends
+      string_view first = arena.name(sorted[begin]);
+      string_view last = arena.name(sorted[end - 1]);
+      size_t common = depth;
+      while(common < first.size() && common < last.size() && first[common] == last[common]
+            && common - depth < UINT16_MAX){
+        common++;
+      }
+
+      labelStart[node] = (uint32_t)labels.size();
+      labelLength[node] = (uint16_t)(common - depth);
+      labels.insert(labels.end(), first.begin() + depth, first.begin() + common);
+      if(common > depth){
+        firstByte[node] = (unsigned char)first[depth];
+      }
+
+      int best = INT32_MIN;
+      if(first.size() == common){
+        vertex[node] = sorted[begin];
+        terminalScore[node] = scores[sorted[begin]];
+        best = terminalScore[node];
+        begin++;
+      }
+
+      // Group the rest by their next byte; one child per group
+      vector<size_t> groupStarts;
+      for(size_t i = begin; i < end; i++){
+        if(i == begin || arena.name(sorted[i])[common] != arena.name(sorted[i - 1])[common]){
+          groupStarts.push_back(i);
+        }
+      }
+      groupStarts.push_back(end);
+      size_t children = groupStarts.size() - 1;
+      uint32_t firstChild = (uint32_t)vertex.size();
+      childBegin[node] = firstChild;
+      childCount[node] = (uint16_t)children;
+      addNodes(children);
+      for(size_t g = 0; g < children; g++){
+        buildNode(firstChild + g, arena, scores, sorted, groupStarts[g], groupStarts[g + 1], common);
+        best = max(best, bestScore[firstChild + g]);
+      }
+      bestScore[node] = best;
+    }
+
+    // Node whose subtree holds exactly the names starting with prefix, -1 if none
+    int findPrefixNode(string_view prefix) const{
+      if(vertex.empty()){
+        return -1;
+      }
+      int node = 0;
+      size_t matched = 0;
+      for(;;){
+        size_t length = min<size_t>(labelLength[node], prefix.size() - matched);
+        if(string_view(labels.data() + labelStart[node], length) != prefix.substr(matched, length)){
+          return -1;
+        }
+        matched += length;
+        if(matched == prefix.size()){
+          return node;
+        }
+        // Label fully matched: descend into the child starting with the next byte
+        unsigned char next = (unsigned char)prefix[matched];
+        uint32_t child = childBegin[node], stop = childBegin[node] + childCount[node];
+        while(child < stop && firstByte[child] != next){
+          child++;
+        }
+        if(child == stop){
+          return -1;
+        }
+        node = (int)child;
+      }
+    }
+
+    template<typename T>
+    static void writeArray(ofstream& out, const vector<T>& values){
+      uint64_t count = values.size();
+      out.write((const char*)&count, sizeof(count));
+      out.write((const char*)values.data(), count * sizeof(T));
+    }
+
+    template<typename T>
+    static bool readArray(ifstream& in, vector<T>& values){
+      uint64_t count;
+      if(!in.read((char*)&count, sizeof(count)) || count > (1ull << 34)){
+        return false;
+      }
+      values.resize(count);
+      return (bool)in.read((char*)values.data(), count * sizeof(T));
+    }
+
+    // Checks array sizes and that every label and child range is in bounds
+    bool isConsistent() const{
+      size_t n = vertex.size();
+      if(n == 0 || labelStart.size() != n || labelLength.size() != n || childBegin.size() != n
+         || childCount.size() != n || firstByte.size() != n || bestScore.size() != n || terminalScore.size() != n){
+        return false;
+      }
+      for(size_t node = 0; node < n; node++){
+        if((uint64_t)labelStart[node] + labelLength[node] > labels.size()
+           || (uint64_t)childBegin[node] + childCount[node] > n
+           || (childCount[node] > 0 && childBegin[node] <= node)){
+          return false;
+        }
+      }
+      return true;
+    }
+};
+
+// Reference: sorted names, binary search for the prefix range, then pick
+// the k best scores from the whole range
+vector<Suggestion> topKByScan(const NameArena& arena, const vector<int>& sortedByName,
+                              const vector<int>& scores, string_view prefix, int k){
+  auto begin = lower_bound(sortedByName.begin(), sortedByName.end(), prefix, [&](int v, string_view p){
+    return arena.name(v) < p;
+  });
+  vector<Suggestion> results;
+  for(auto it = begin; it != sortedByName.end() && arena.name(*it).substr(0, prefix.size()) == prefix; ++it){
+    results.push_back({*it, scores[*it]});
+  }
+  int count = min<int>(k, results.size());
+  partial_sort(results.begin(), results.begin() + count, results.end(), [](const Suggestion& a, const Suggestion& b){
+    return a.score > b.score;
+  });
+  results.resize(count);
+  return results;
+}
+
+// Synthetic place names of varying length, e.g. "Station 5531 North"
+vector<string> generateNames(int count, unsigned seed){
+  static const char* prefixes[] = {"Station", "Market", "Old Town", "Harbour", "University", "Bridge"};
+  static const char* suffixes[] = {"", " North", " South", " Junction", " Central Depot"};
+  mt19937 rng(seed);
+  vector<string> names(count);
+  for(int i = 0; i < count; i++){
+    names[i] = string(prefixes[rng() % 6]) + " " + to_string(i) + suffixes[rng() % 5];
+  }
+  return names;
+}
+
+// Build time, size, a save/load round trip and top-k query latency against
+// the sorted-array scan, for prefixes of one to eight characters
+// Usage: ./place_autocomplete bench [names] [queries]
+void runBenchmark(int count, int queries){
+  vector<string> names = generateNames(count, 42);
+  NameArena arena;
+  mt19937 rng(7);
+  vector<int> scores(count);
+  for(int v = 0; v < count; v++){
+    arena.add(names[v]);
+    scores[v] = (int)(rng() % 1000000);  // Distinct enough that ties are rare
+  }
+
+  auto t0 = chrono::steady_clock::now();
+  PlaceAutocomplete trie(arena, scores);
+  auto t1 = chrono::steady_clock::now();
+  trie.save("autocomplete_bench.bin");
+  PlaceAutocomplete loaded;
+  bool loadedOk = loaded.load("autocomplete_bench.bin");
+  auto t2 = chrono::steady_clock::now();
+  remove("autocomplete_bench.bin");
+
+  vector<int> sortedByName(count);
+  iota(sortedByName.begin(), sortedByName.end(), 0);
+  sort(sortedByName.begin(), sortedByName.end(), [&](int a, int b){ return arena.name(a) < arena.name(b); });
+
+  cout << count << " names: " << trie.nodeCount() << " nodes, " << (double)trie.memoryBytes() / count
+       << " bytes/name, build " << chrono::duration<double>(t1 - t0).count() * 1000 << " ms, save + load "
+       << chrono::duration<double>(t2 - t1).count() * 1000 << " ms" << (loadedOk ? "" : " (load FAILED)") << endl;
+
+  for(int length : {1, 2, 4, 8}){
+    vector<string> prefixes(queries);
+    for(string& prefix : prefixes){
+      prefix = names[rng() % count].substr(0, length);
+    }
+    int k = 10;
+    size_t found = 0, scanned = 0;
+    auto t3 = chrono::steady_clock::now();
+    for(const string& prefix : prefixes){
+      found += loaded.topK(prefix, k).size();
+    }
+    double trieSeconds = chrono::duration<double>(chrono::steady_clock::now() - t3).count();
+    auto t4 = chrono::steady_clock::now();
+    for(const string& prefix : prefixes){
+      scanned += topKByScan(arena, sortedByName, scores, prefix, k).size();
+    }
+    double scanSeconds = chrono::duration<double>(chrono::steady_clock::now() - t4).count();
+
+    // Compare score lists (vertices may differ only on tied scores)
+    bool same = found == scanned;
+    for(int i = 0; i < min(queries, 200); i++){
+      vector<Suggestion> a = loaded.topK(prefixes[i], k), b = topKByScan(arena, sortedByName, scores, prefixes[i], k);
+      same = same && a.size() == b.size();
+      for(size_t j = 0; same && j < a.size(); j++){
+        same = a[j].score == b[j].score;
+      }
+    }
+    cout << "  prefix length " << length << ": trie " << trieSeconds / queries * 1e6 << " us, scan "
+         << scanSeconds / queries * 1e6 << " us" << (same ? "" : " (MISMATCH)") << endl;
+  }
+}
+
+// Main function: suggestions while typing on a small example map
+int main(int argc, char* argv[]){
+
+  if(argc > 1 && string(argv[1]) == "bench"){
+    int count = argc > 2 ? stoi(argv[2]) : 1000000;
+    int queries = argc > 3 ? stoi(argv[3]) : 2000;
+    runBenchmark(count, queries);
+    return 0;
+  }
+
+  NameArena arena;
+  vector<int> scores;
+  for(auto place : {make_pair("Central Station", 90), make_pair("Central Park", 70),
+                    make_pair("Cathedral", 50), make_pair("Harbour", 40), make_pair("Centre Court", 60)}){
+    arena.add(place.first);
+    scores.push_back(place.second);
+  }
+  PlaceAutocomplete trie(arena, scores);
+
+  for(string typed : {"C", "Cen", "Central P", "X"}){
+    cout << "\"" << typed << "\":";
+    for(const Suggestion& suggestion : trie.topK(typed, 3)){
+      cout << " " << arena.name(suggestion.vertex);
+    }
+    cout << endl;
+  }
+  return 0;
+}
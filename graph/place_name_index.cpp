@@ -0,0 +1,336 @@
+#include<iostream>
+#include<vector>
+#include<string>
+#include<string_view>
+#include<algorithm>
+#include<numeric>
+#include<unordered_map>
+#include<cstdint>
+#include<cstring>
+#include<chrono>
+#include<random>
+using namespace std;
+
+// Name-to-vertex lookup without per-name allocations
+//
+// A std::string per place costs 32 bytes of object plus a heap block for
+// any name longer than the small-string buffer, and a hash map from name to
+// vertex adds a node, a bucket and another copy of the key on top.
+//
+// NameArena stores every name back to back in one char buffer with an
+// offset per vertex, so vertex v's name is bytes[offsets[v] .. offsets[v+1]).
+// PlaceNameIndex is a minimal perfect hash (CHD: "compress, hash and
+// displace") built once over the arena: each distinct name maps to its own
+// slot in [0, n) with no empty slots. A slot holds the vertex id and the
+// name's position in the arena, so a lookup is one hash, one displacement
+// read, one slot read and one string compare against the arena bytes to
+// reject names that were never inserted.
+
+// All place names in one contiguous buffer, indexed by vertex id
+class NameArena{
+  public:
+    NameArena() : offsets(1, 0){}
+
+    // Appends a name and returns its vertex id
+    int add(string_view name){
+      bytes.insert(bytes.end(), name.begin(), name.end());
+      offsets.push_back((uint32_t)bytes.size());
+      return (int)offsets.size() - 2;
+    }
+
+    string_view name(int vertex) const{
+      return string_view(bytes.data() + offsets[vertex], offsets[vertex + 1] - offsets[vertex]);
+    }
+
+    int size() const{
+      return (int)offsets.size() - 1;
+    }
+
+    // Raw access for indexes that keep their own (offset, length) pairs
+    const char* data() const{
+      return bytes.data();
+    }
+
+    uint32_t offset(int vertex) const{
+      return offsets[vertex];
+    }
+
+    size_t memoryBytes() const{
+      return bytes.capacity() + offsets.capacity() * sizeof(uint32_t);
+    }
+
+  private:
+    vector<char> bytes;
+    vector<uint32_t> offsets;  // Size V + 1
+};
+
+// 64-bit seeded hash over 8-byte words
+static uint64_t mix(uint64_t x){
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdULL;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ULL;
+  x ^= x >> 33;
+  return x;
+}
+
+static uint64_t hashName(string_view name, uint64_t seed){
+  uint64_t h = seed ^ (name.size() * 0x9e3779b97f4a7c15ULL);
+  size_t i = 0;
+  for(; i + 8 <= name.size(); i += 8){
+    uint64_t word;
+    memcpy(&word, name.data() + i, 8);
+    h = mix(h ^ word) * 0x9e3779b97f4a7c15ULL;
+  }
+  uint64_t tail = 0;
+  memcpy(&tail, name.data() + i, name.size() - i);
+  return mix(h ^ tail);
+}
+
+// Static minimal perfect hash from name to vertex id over a NameArena
+// If several vertices share a name, the lowest vertex id is returned
+class PlaceNameIndex{
+  public:
+    // Builds the index; the arena must outlive it and must not change
+    explicit PlaceNameIndex(const NameArena& arena) : arena(arena), seed(0x2545f4914f6cdd1dULL){
+      while(!tryBuild()){
+        seed = mix(seed + 1);
+      }
+    }
+
+    // Vertex id of name, -1 if no place has that name
+    int find(string_view name) const{
+      if(slots.empty()){
+        return -1;
+      }
+      const Slot& slot = slots[slotOf(hashName(name, seed))];
+      return string_view(arena.data() + slot.nameOffset, slot.nameLength) == name ? (int)slot.vertex : -1;
+    }
+
+    size_t distinctNames() const{
+      return slots.size();
+    }
+
+    size_t memoryBytes() const{
+      return displacements.capacity() * sizeof(uint32_t) + slots.capacity() * sizeof(Slot);
+    }
+
+  private:
+    static const int keysPerBucket = 4;  // Average bucket size: ~8 bits of displacement per name
+
+    const NameArena& arena;
+    uint64_t seed;
+    // Name position is kept next to the vertex so the compare does not
+    // need a separate read of the arena offsets
+    struct Slot{
+      uint32_t vertex;
+      uint32_t nameOffset;
+      uint32_t nameLength;
+    };
+
+    vector<uint32_t> displacements;  // One per bucket
+    vector<Slot> slots;              // One per distinct name
+
+    size_t bucketOf(uint64_t hash) const{
+      return (hash >> 32) % displacements.size();
+    }
+
+    // Each displacement re-scrambles the hash, so successive tries for a
+    // bucket land on independent slots; the multiply-shift maps the 64-bit
+    // value onto [0, n) without a division
+    size_t slotOf(uint64_t hash, uint32_t displacement) const{
+      uint64_t scrambled = mix(hash + displacement * 0x9e3779b97f4a7c15ULL);
+      return (size_t)(((unsigned __int128)scrambled * slots.size()) >> 64);
+    }
+
+    size_t slotOf(uint64_t hash) const{
+      return slotOf(hash, displacements[bucketOf(hash)]);
+    }
+
+    // One CHD attempt with the current seed; false if two distinct names
+    // share a full hash or a bucket cannot be placed
+    bool tryBuild(){
+      int vertexCount = arena.size();
+      vector<uint64_t> hashes(vertexCount);
+      for(int v = 0; v < vertexCount; v++){
+        hashes[v] = hashName(arena.name(v), seed);
+      }
+
+      // Keep the lowest vertex of each distinct name; equal names have equal
+      // hashes, so sorting by (hash, vertex) makes them adjacent
+      vector<int> keys(vertexCount);
+      iota(keys.begin(), keys.end(), 0);
+      sort(keys.begin(), keys.end(), [&](int a, int b){
+        return hashes[a] != hashes[b] ? hashes[a] < hashes[b] : a < b;
+      });
+      size_t distinct = 0;
+      for(size_t i = 0; i < keys.size(); i++){
+        if(distinct > 0 && hashes[keys[distinct - 1]] == hashes[keys[i]]){
+          if(arena.name(keys[distinct - 1]) != arena.name(keys[i])){
+            return false;
+          }
+          continue;
+        }
+        keys[distinct++] = keys[i];
+      }
+      keys.resize(distinct);
+
+      slots.assign(distinct, Slot());
+      displacements.assign(max<size_t>(1, distinct / keysPerBucket), 0);
+      if(distinct == 0){
+        return true;
+      }
+
+      // Group keys by bucket (counting sort), then place big buckets first
+      size_t bucketCount = displacements.size();
+      vector<uint32_t> bucketStart(bucketCount + 1, 0);
+      for(int key : keys){
+        bucketStart[bucketOf(hashes[key]) + 1]++;
+      }
+      for(size_t b = 0; b < bucketCount; b++){
+        bucketStart[b + 1] += bucketStart[b];
+      }
+      vector<int> bucketKeys(distinct);
+      vector<uint32_t> next(bucketStart.begin(), bucketStart.end() - 1);
+      for(int key : keys){
+        bucketKeys[next[bucketOf(hashes[key])]++] = key;
+      }
+      vector<uint32_t> order(bucketCount);
+      iota(order.begin(), order.end(), 0);
+      sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b){
+        return bucketStart[a + 1] - bucketStart[a] > bucketStart[b + 1] - bucketStart[b];
+      });
+
+      vector<bool> taken(distinct, false);
+      vector<size_t> chosen;
+      for(uint32_t bucket : order){
+        uint32_t begin = bucketStart[bucket], end = bucketStart[bucket + 1];
+        if(begin == end){
+          break;  // Buckets are sorted by size, the rest are empty too
+        }
+        bool placed = false;
+        for(uint32_t d = 0; d < (1u << 30) && !placed; d++){
+          chosen.clear();
+          placed = true;
+          for(uint32_t i = begin; i < end && placed; i++){
+            size_t slot = slotOf(hashes[bucketKeys[i]], d);
+            placed = !taken[slot] && std::find(chosen.begin(), chosen.end(), slot) == chosen.end();
+            chosen.push_back(slot);
+          }
+          if(placed){
+            displacements[bucket] = d;
+            for(uint32_t i = begin; i < end; i++){
+              taken[chosen[i - begin]] = true;
+              int vertex = bucketKeys[i];
+              slots[chosen[i - begin]] = {(uint32_t)vertex, arena.offset(vertex), (uint32_t)arena.name(vertex).size()};
+            }
+          }
+        }
+        if(!placed){
+          return false;
+        }
+      }
+      return true;
+    }
+};
+
+// Synthetic place names of varying length, e.g. "Station 5531 North"
+vector<string> generateNames(int count, unsigned seed){
+  static const char* prefixes[] = {"Station", "Market", "Old Town", "Harbour", "University", "Bridge"};
+  static const char* suffixes[] = {"", " North", " South", " Junction", " Central Depot"};
+  mt19937 rng(seed);
+  vector<string> names(count);
+  for(int i = 0; i < count; i++){
+    names[i] = string(prefixes[rng() % 6]) + " " + to_string(i) + suffixes[rng() % 5];
+  }
+  return names;
+}
+
+// Build time, memory and lookup time of the arena + perfect hash against
+// vector<string> + unordered_map<string, int>
+// Usage: ./place_name_index bench [names] [lookups]
+void runBenchmark(int count, int lookups){
+  vector<string> names = generateNames(count, 42);
+  mt19937 rng(7);
+  vector<string> queries(lookups);
+  for(string& query : queries){
+    // Nine in ten queries hit, the rest are names that do not exist
+    query = rng() % 10 ? names[rng() % count] : "Nowhere " + to_string(rng());
+  }
+
+  auto t0 = chrono::steady_clock::now();
+  NameArena arena;
+  for(const string& name : names){
+    arena.add(name);
+  }
+  PlaceNameIndex index(arena);
+  double buildSeconds = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+
+  auto t1 = chrono::steady_clock::now();
+  unordered_map<string, int> byName;
+  byName.reserve(count);
+  for(int v = 0; v < count; v++){
+    byName.emplace(names[v], v);
+  }
+  double mapBuildSeconds = chrono::duration<double>(chrono::steady_clock::now() - t1).count();
+
+  long long checksum = 0;
+  auto t2 = chrono::steady_clock::now();
+  for(const string& query : queries){
+    checksum += index.find(query);
+  }
+  double indexSeconds = chrono::duration<double>(chrono::steady_clock::now() - t2).count();
+
+  long long mapChecksum = 0;
+  auto t3 = chrono::steady_clock::now();
+  for(const string& query : queries){
+    auto it = byName.find(query);
+    mapChecksum += it == byName.end() ? -1 : it->second;
+  }
+  double mapSeconds = chrono::duration<double>(chrono::steady_clock::now() - t3).count();
+
+  // std::string memory: object plus a heap block past the SSO buffer;
+  // unordered_map: node (next pointer, key copy, value, cached hash) + bucket
+  size_t stringBytes = 0, mapBytes = byName.bucket_count() * sizeof(void*);
+  for(const string& name : names){
+    size_t heap = name.capacity() > 15 ? name.capacity() + 1 : 0;
+    stringBytes += sizeof(string) + heap;
+    mapBytes += sizeof(void*) + sizeof(string) + heap + sizeof(int) + sizeof(size_t);
+  }
+
+  cout << count << " names, " << lookups << " lookups" << endl;
+  cout << "  arena + perfect hash: build " << buildSeconds * 1000 << " ms, "
+       << (double)(arena.memoryBytes() + index.memoryBytes()) / count << " bytes/name, lookup "
+       << indexSeconds / lookups * 1e9 << " ns" << endl;
+  cout << "  strings + unordered_map: build " << mapBuildSeconds * 1000 << " ms, "
+       << (double)(stringBytes + mapBytes) / count << " bytes/name, lookup "
+       << mapSeconds / lookups * 1e9 << " ns" << (checksum == mapChecksum ? "" : " (MISMATCH)") << endl;
+}
+
+// Main function: resolves user input against the small example map
+int main(int argc, char* argv[]){
+
+  if(argc > 1 && string(argv[1]) == "bench"){
+    int count = argc > 2 ? stoi(argv[2]) : 1000000;
+    int lookups = argc > 3 ? stoi(argv[3]) : 1000000;
+    runBenchmark(count, lookups);
+    return 0;
+  }
+
+  NameArena arena;
+  for(const char* name : {"A", "B", "C", "D"}){
+    arena.add(name);
+  }
+  PlaceNameIndex index(arena);
+
+  for(const char* query : {"C", "A", "E"}){
+    int vertex = index.find(query);
+    if(vertex == -1){
+      cout << query << ": unknown place" << endl;
+    }
+    else{
+      cout << query << ": vertex " << vertex << endl;
+    }
+  }
+  return 0;
+}
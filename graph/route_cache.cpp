@@ -0,0 +1,383 @@
+#include<iostream>
+#include<vector>
+#include<string>
+#include<algorithm>
+#include<list>
+#include<unordered_map>
+#include<thread>
+#include<mutex>
+#include<atomic>
+#include<climits>
+#include<cstdint>
+#include<chrono>
+#include<random>
+using namespace std;
+
+// Bounded LRU cache for repeated origin/destination route queries
+//
+// Entries are keyed by (start, destination, graph version) and hold the
+// distance and the vertex path. The cache is split into shards by a hash of
+// (start, destination), each with its own lock, list and map, so concurrent
+// queries for different pairs rarely contend. Each shard evicts its least
+// recently used entries once it exceeds its share of the memory budget.
+//
+// The cache tracks the newest graph version any caller has used, and each
+// shard remembers the version its entries belong to. The first access to a
+// shard after the version moved on drops all of that shard's entries at
+// once, so results for an old graph are never returned and stop using the
+// budget as soon as traffic reaches their shard.
+
+// A single directed, weighted edge between two vertex ids
+struct Edge{
+  int from;
+  int to;
+  int weight;
+};
+
+// A cached answer: distance (INT_MAX if unreachable) and path start -> destination
+struct CachedRoute{
+  int distance;
+  vector<int> path;
+};
+
+// Counters for sizing the cache; taken with RouteCache::stats()
+struct RouteCacheStats{
+  uint64_t hits;
+  uint64_t misses;
+  uint64_t evictions;      // Entries dropped to stay under the memory budget
+  uint64_t invalidations;  // Entries dropped because the graph version changed
+  size_t entries;
+  size_t bytes;
+};
+
+class RouteCache{
+  public:
+    RouteCache(size_t memoryBudgetBytes, int shardCount)
+      : shards(max(1, shardCount)), shardBudget(memoryBudgetBytes / max(1, shardCount)){}
+
+    // Copies the cached route into route and marks it most recently used
+    // Returns: false on a miss (including entries of an older graph version)
+    bool lookup(int start, int destination, uint64_t version, CachedRoute& route){
+      Key key = {start, destination, version};
+      Shard& shard = shardOf(key);
+      lock_guard<mutex> lock(shard.m);
+      invalidateOlder(shard, noteVersion(version));
+      auto found = shard.index.find(key);
+      if(found == shard.index.end()){
+        misses.fetch_add(1, memory_order_relaxed);
+        return false;
+      }
+      shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+      route = found->second->route;
+      hits.fetch_add(1, memory_order_relaxed);
+      return true;
+    }
+
+    // Stores a route, evicting least recently used entries of the same shard
+    // until it fits. Routes bigger than a whole shard budget are not cached
+    void insert(int start, int destination, uint64_t version, const CachedRoute& route){
+      Key key = {start, destination, version};
+      Shard& shard = shardOf(key);
+      size_t bytes = entryBytes(route);
+      if(bytes > shardBudget){
+        return;
+      }
+      lock_guard<mutex> lock(shard.m);
+      invalidateOlder(shard, noteVersion(version));
+      if(version < shard.version){
+        return;  // Computed on a graph that has already been replaced
+      }
+
+      auto found = shard.index.find(key);
+      if(found != shard.index.end()){
+        shard.bytes -= found->second->bytes;
+        shard.entries.erase(found->second);
+        shard.index.erase(found);
+      }
+      while(!shard.entries.empty() && shard.bytes + bytes > shardBudget){
+        Entry& oldest = shard.entries.back();
+        shard.bytes -= oldest.bytes;
+        shard.index.erase(oldest.key);
+        shard.entries.pop_back();
+        evictions.fetch_add(1, memory_order_relaxed);
+      }
+      shard.entries.push_front({key, route, bytes});
+      shard.index[key] = shard.entries.begin();
+      shard.bytes += bytes;
+    }
+
+    RouteCacheStats stats(){
+      RouteCacheStats result = {hits.load(), misses.load(), evictions.load(), invalidations.load(), 0, 0};
+      for(Shard& shard : shards){
+        lock_guard<mutex> lock(shard.m);
+        result.entries += shard.entries.size();
+        result.bytes += shard.bytes;
+      }
+      return result;
+    }
+
+  private:
+    struct Key{
+      int start;
+      int destination;
+      uint64_t version;
+
+      bool operator==(const Key& other) const{
+        return start == other.start && destination == other.destination && version == other.version;
+      }
+    };
+
+    struct KeyHash{
+      size_t operator()(const Key& key) const{
+        uint64_t h = ((uint64_t)(uint32_t)key.start << 32 | (uint32_t)key.destination) ^ (key.version * 0x9e3779b97f4a7c15ull);
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        return (size_t)h;
+      }
+    };
+
+    struct Entry{
+      Key key;
+      CachedRoute route;
+      size_t bytes;  // Charged against the shard budget
+    };
+
+    struct Shard{
+      mutex m;
+      list<Entry> entries;  // Most recently used first
+      unordered_map<Key, list<Entry>::iterator, KeyHash> index;
+      size_t bytes = 0;
+      uint64_t version = 0;  // Graph version of the entries in this shard
+    };
+
+    vector<Shard> shards;
+    size_t shardBudget;
+    atomic<uint64_t> hits{0}, misses{0}, evictions{0}, invalidations{0};
+    atomic<uint64_t> latestVersion{0};
+
+    // All versions of one pair land in the same shard, so a newer version
+    // always meets (and drops) the older entry. The high hash bits are used
+    // so the shard choice is independent of the bucket inside the shard
+    Shard& shardOf(const Key& key){
+      Key pairOnly = {key.start, key.destination, 0};
+      return shards[(KeyHash()(pairOnly) >> 40) % shards.size()];
+    }
+
+    // Raises latestVersion to version if it is newer; returns the latest
+    uint64_t noteVersion(uint64_t version){
+      uint64_t latest = latestVersion.load(memory_order_relaxed);
+      while(version > latest && !latestVersion.compare_exchange_weak(latest, version, memory_order_relaxed)){
+      }
+      return max(latest, version);
+    }
+
+    // Approximate memory of one entry: list node, map node and bucket, path
+    static size_t entryBytes(const CachedRoute& route){
+      return sizeof(Entry) + 2 * sizeof(void*)
+           + sizeof(pair<const Key, list<Entry>::iterator>) + 3 * sizeof(void*)
+           + route.path.size() * sizeof(int);
+    }
+
+    // Drops the whole shard when its entries belong to an older graph version
+    void invalidateOlder(Shard& shard, uint64_t version){
+      if(version <= shard.version){
+        return;
+      }
+      invalidations.fetch_add(shard.entries.size(), memory_order_relaxed);
+      shard.entries.clear();
+      shard.index.clear();
+      shard.bytes = 0;
+      shard.version = version;
+    }
+};
+
+// Immutable CSR graph (same layout as CsrGraph in map_navigation.cpp)
+class CsrGraph{
+  public:
+    vector<int> offsets;
+    vector<int> targets;
+    vector<int> weights;
+
+    CsrGraph(int vertexCount, const vector<Edge>& edges) : offsets(vertexCount + 1, 0){
+      for(const Edge& edge : edges){
+        offsets[edge.from + 1]++;
+      }
+      for(int v = 0; v < vertexCount; v++){
+        offsets[v + 1] += offsets[v];
+      }
+      targets.resize(edges.size());
+      weights.resize(edges.size());
+      vector<int> next(offsets.begin(), offsets.end() - 1);
+      for(const Edge& edge : edges){
+        int slot = next[edge.from]++;
+        targets[slot] = edge.to;
+        weights[slot] = edge.weight;
+      }
+    }
+
+    int vertexCount() const{
+      return (int)offsets.size() - 1;
+    }
+};
+
+// Dijkstra's Algorithm returning the distance and the path
+CachedRoute findShortestPath(const CsrGraph& graph, int start, int destination){
+  vector<int> distances(graph.vertexCount(), INT_MAX), parent(graph.vertexCount(), -1);
+  typedef pair<int, int> HeapEntry;
+  vector<HeapEntry> heap;
+  distances[start] = 0;
+  heap.push_back(HeapEntry(0, start));
+  while(!heap.empty()){
+    pop_heap(heap.begin(), heap.end(), greater<HeapEntry>());
+    HeapEntry top = heap.back();
+    heap.pop_back();
+    if(top.first > distances[top.second]){
+      continue;
+    }
+    if(top.second == destination){
+      break;
+    }
+    for(int e = graph.offsets[top.second]; e < graph.offsets[top.second + 1]; e++){
+      int newDistance = top.first + graph.weights[e];
+      if(newDistance < distances[graph.targets[e]]){
+        distances[graph.targets[e]] = newDistance;
+        parent[graph.targets[e]] = top.second;
+        heap.push_back(HeapEntry(newDistance, graph.targets[e]));
+        push_heap(heap.begin(), heap.end(), greater<HeapEntry>());
+      }
+    }
+  }
+
+  CachedRoute route = {distances[destination], {}};
+  if(route.distance != INT_MAX){
+    for(int v = destination; v != -1; v = parent[v]){
+      route.path.push_back(v);
+    }
+    reverse(route.path.begin(), route.path.end());
+  }
+  return route;
+}
+
+// Answers from the cache when possible, otherwise searches and caches
+CachedRoute cachedRoute(RouteCache& cache, const CsrGraph& graph, uint64_t version, int start, int destination){
+  CachedRoute route;
+  if(!cache.lookup(start, destination, version, route)){
+    route = findShortestPath(graph, start, destination);
+    cache.insert(start, destination, version, route);
+  }
+  return route;
+}
+
+// Road-like side x side grid with random weights in [1, 100] in both directions
+vector<Edge> buildGridEdges(int side, unsigned seed){
+  mt19937 rng(seed);
+  uniform_int_distribution<int> weight(1, 100);
+  vector<Edge> edges;
+  for(int row = 0; row < side; row++){
+    for(int col = 0; col < side; col++){
+      int here = row * side + col;
+      if(col + 1 < side){
+        int w = weight(rng);
+        edges.push_back({here, here + 1, w});
+        edges.push_back({here + 1, here, w});
+      }
+      if(row + 1 < side){
+        int w = weight(rng);
+        edges.push_back({here, here + side, w});
+        edges.push_back({here + side, here, w});
+      }
+    }
+  }
+  return edges;
+}
+
+// Skewed workload: a few hundred hot origin/destination pairs get most of
+// the traffic. Several threads query through the cache; halfway through the
+// graph version is bumped to show the invalidation
+// Usage: ./route_cache bench [side] [queries per thread] [threads] [budget KiB]
+void runBenchmark(int side, int queries, int threads, size_t budgetKiB){
+  CsrGraph graph(side * side, buildGridEdges(side, 42));
+  int n = graph.vertexCount();
+  RouteCache cache(budgetKiB * 1024, 16);
+
+  mt19937 pairRng(1);
+  vector<pair<int, int> > hotPairs(500);
+  for(pair<int, int>& hot : hotPairs){
+    hot = make_pair((int)(pairRng() % n), (int)(pairRng() % n));
+  }
+
+  atomic<uint64_t> version(1);
+  auto t0 = chrono::steady_clock::now();
+  vector<thread> workers;
+  for(int t = 0; t < threads; t++){
+    workers.push_back(thread([&, t](){
+      mt19937 rng(t + 10);
+      for(int q = 0; q < queries; q++){
+        if(t == 0 && q == queries / 2){
+          version++;  // Traffic update published
+        }
+        // 90% of queries hit the hot pairs, with a Zipf-like skew towards the first ones
+        int start, destination;
+        if(rng() % 10 != 0){
+          double u = (rng() % 1000000) / 1000000.0;
+          const pair<int, int>& hot = hotPairs[(size_t)(u * u * u * hotPairs.size())];
+          start = hot.first;
+          destination = hot.second;
+        }
+        else{
+          start = rng() % n;
+          destination = rng() % n;
+        }
+        cachedRoute(cache, graph, version.load(), start, destination);
+      }
+    }));
+  }
+  for(thread& worker : workers){
+    worker.join();
+  }
+  double seconds = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+
+  RouteCacheStats stats = cache.stats();
+  cout << "Grid " << side << "x" << side << ", " << threads << " threads x " << queries << " queries, "
+       << budgetKiB << " KiB budget" << endl;
+  cout << "  hits " << stats.hits << ", misses " << stats.misses << " (hit rate "
+       << 100.0 * stats.hits / max<uint64_t>(1, stats.hits + stats.misses) << "%)" << endl;
+  cout << "  evictions " << stats.evictions << ", invalidations " << stats.invalidations << endl;
+  cout << "  " << stats.entries << " entries, " << stats.bytes / 1024 << " KiB in use" << endl;
+  cout << "  " << seconds * 1e6 / (queries * (double)threads) << " us/query" << endl;
+}
+
+// Main function: repeated queries on the small example map
+int main(int argc, char* argv[]){
+
+  if(argc > 1 && string(argv[1]) == "bench"){
+    int side = argc > 2 ? stoi(argv[2]) : 200;
+    int queries = argc > 3 ? stoi(argv[3]) : 2000;
+    int threads = argc > 4 ? stoi(argv[4]) : 4;
+    size_t budget = argc > 5 ? stoul(argv[5]) : 1024;
+    runBenchmark(side, queries, threads, budget);
+    return 0;
+  }
+
+  // Graph structure (ids: A=0, B=1, C=2, D=3):
+  //   A --10--> B --15--> D
+  //    \                 /
+  //     5----> C --20---
+  vector<string> names = {"A", "B", "C", "D"};
+  CsrGraph graph(4, {{0, 1, 10}, {0, 2, 5}, {1, 3, 15}, {2, 3, 20}});
+  RouteCache cache(64 * 1024, 4);
+
+  for(uint64_t version : {1, 1, 1, 2}){
+    CachedRoute route = cachedRoute(cache, graph, version, 0, 3);
+    cout << "Version " << version << ", A to D: " << route.distance << " via";
+    for(int v : route.path){
+      cout << " " << names[v];
+    }
+    cout << endl;
+  }
+
+  RouteCacheStats stats = cache.stats();
+  cout << "Hits: " << stats.hits << ", misses: " << stats.misses << ", invalidated: " << stats.invalidations << endl;
+  return 0;
+}
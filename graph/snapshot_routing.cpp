@@ -0,0 +1,431 @@
+#include<iostream>
+#include<vector>
+#include<string>
+#include<algorithm>
+#include<memory>
+#include<thread>
+#include<mutex>
+#include<atomic>
+#include<climits>
+#include<cstdint>
+#include<stdexcept>
+#include<chrono>
+#include<random>
+using namespace std;
+
+// Snapshot-isolated routing: lock-free readers, atomically swapped versions
+//
+// Query threads read an immutable GraphVersion while one background writer
+// applies weight updates. A writer never modifies a published version; it
+// builds the next version and publishes it with one atomic pointer store
+// (read-copy-update).
+//
+// Copy-on-write: adjacency is split into blocks of blockSize vertices, and a
+// version is just a vector of shared pointers to blocks. The next version
+// shares every block that did not change and copies only the touched ones.
+//
+// Reclamation is epoch based. Each query thread holds a ReaderHandle that
+// claims one of maxReaders slots and frees it again when it goes away. A
+// reader announces the global epoch in its slot before loading the current
+// version and clears the slot when done.
+// A replaced version is tagged with the epoch that follows its replacement,
+// and it is freed once every reader slot is empty or shows at least that
+// epoch. Readers never take a lock, never touch a reference count and never
+// wait for the writer, so publishing does not stall queries.
+
+// A single directed, weighted edge between two vertex ids
+struct Edge{
+  int from;
+  int to;
+  int weight;
+};
+
+// New weight for the edge from -> to
+struct WeightUpdate{
+  int from;
+  int to;
+  int weight;
+};
+
+// CSR adjacency of the vertices firstVertex .. firstVertex + blockSize - 1
+struct AdjacencyBlock{
+  vector<int> offsets;  // Local: edges of vertex firstVertex + i are offsets[i] .. offsets[i + 1] - 1
+  vector<int> targets;
+  vector<int> weights;
+};
+
+const int blockShift = 10;
+const int blockSize = 1 << blockShift;
+
+// One immutable version of the whole graph
+struct GraphVersion{
+  uint64_t version;
+  int vertexCount;
+  vector<shared_ptr<const AdjacencyBlock> > blocks;
+
+  // Block holding the adjacency of a vertex
+  const AdjacencyBlock& blockOf(int vertex) const{
+    return *blocks[vertex >> blockShift];
+  }
+};
+
+class VersionedGraph;
+
+// RAII claim on one reader slot of a graph, held by one query thread for as
+// long as it takes snapshots. Throws if all maxReaders slots are in use
+class ReaderHandle{
+  public:
+    explicit ReaderHandle(VersionedGraph& graph);
+    ~ReaderHandle();
+    ReaderHandle(const ReaderHandle&) = delete;
+    ReaderHandle& operator=(const ReaderHandle&) = delete;
+
+  private:
+    friend class Snapshot;
+    VersionedGraph& graph;
+    int slot;
+};
+
+// RAII pin on the current version. While it exists the version it returned
+// stays valid, however many newer versions get published. A handle holds
+// at most one snapshot at a time
+class Snapshot{
+  public:
+    explicit Snapshot(ReaderHandle& reader);
+    ~Snapshot();
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+
+    const GraphVersion& graph() const{
+      return *pinned;
+    }
+
+  private:
+    atomic<uint64_t>& slot;
+    const GraphVersion* pinned;
+};
+
+class VersionedGraph{
+  public:
+    static const int maxReaders = 128;
+
+    VersionedGraph(int vertexCount, const vector<Edge>& edges) : publishedVersion(1), globalEpoch(1){
+      for(ReaderSlot& slot : slots){
+        slot.inUse.store(false, memory_order_relaxed);
+        slot.epoch.store(0, memory_order_relaxed);
+      }
+
+      GraphVersion* first = new GraphVersion();
+      first->version = 1;
+      first->vertexCount = vertexCount;
+      vector<vector<Edge> > byBlock((vertexCount + blockSize - 1) / blockSize);
+      for(const Edge& edge : edges){
+        byBlock[edge.from >> blockShift].push_back(edge);
+      }
+      for(size_t b = 0; b < byBlock.size(); b++){
+        first->blocks.push_back(make_shared<const AdjacencyBlock>(buildBlock((int)b, byBlock[b])));
+      }
+      current.store(first, memory_order_seq_cst);
+    }
+
+    ~VersionedGraph(){
+      for(Retired& retired : retiredVersions){
+        delete retired.graph;
+      }
+      delete current.load();
+    }
+
+    // Latest published version number (readable without pinning)
+    uint64_t currentVersion() const{
+      return publishedVersion.load(memory_order_acquire);
+    }
+
+    // Builds and publishes the next version with the given weights changed
+    // Only blocks that contain a changed edge are copied. Updates of edges
+    // that do not exist are ignored. Safe to call from several writers
+    // Returns: the new version number
+    uint64_t publish(const vector<WeightUpdate>& updates){
+      lock_guard<mutex> lock(writerMutex);
+      const GraphVersion* old = current.load(memory_order_acquire);
+      GraphVersion* next = new GraphVersion(*old);  // Copies block pointers only
+      next->version = old->version + 1;
+
+      vector<shared_ptr<AdjacencyBlock> > copies(next->blocks.size());
+      for(const WeightUpdate& update : updates){
+        int b = update.from >> blockShift;
+        if(copies[b] == nullptr){
+          copies[b] = make_shared<AdjacencyBlock>(*next->blocks[b]);
+          next->blocks[b] = copies[b];
+        }
+        AdjacencyBlock& block = *copies[b];
+        int local = update.from & (blockSize - 1);
+        for(int e = block.offsets[local]; e < block.offsets[local + 1]; e++){
+          if(block.targets[e] == update.to){
+            block.weights[e] = update.weight;
+          }
+        }
+      }
+
+      // Swap, then open a new epoch: readers that announce it or a later one
+      // are guaranteed to load the new version
+      current.store(next, memory_order_seq_cst);
+      publishedVersion.store(next->version, memory_order_release);
+      uint64_t retireEpoch = globalEpoch.fetch_add(1, memory_order_seq_cst) + 1;
+      retiredVersions.push_back({old, retireEpoch});
+      reclaim();
+      return next->version;
+    }
+
+    // Number of replaced versions still waiting for readers to move on
+    size_t pendingReclamation(){
+      lock_guard<mutex> lock(writerMutex);
+      reclaim();
+      return retiredVersions.size();
+    }
+
+  private:
+    friend class ReaderHandle;
+    friend class Snapshot;
+
+    // One cache line per reader so announcements do not false-share
+    struct alignas(64) ReaderSlot{
+      atomic<bool> inUse;      // Claimed by a ReaderHandle
+      atomic<uint64_t> epoch;  // 0 = not reading
+    };
+
+    struct Retired{
+      const GraphVersion* graph;
+      uint64_t epoch;
+    };
+
+    atomic<const GraphVersion*> current;
+    atomic<uint64_t> publishedVersion;
+    atomic<uint64_t> globalEpoch;
+    ReaderSlot slots[maxReaders];
+    mutex writerMutex;
+    vector<Retired> retiredVersions;  // Guarded by writerMutex
+
+    static AdjacencyBlock buildBlock(int blockIndex, const vector<Edge>& edges){
+      AdjacencyBlock block;
+      block.offsets.assign(blockSize + 1, 0);
+      for(const Edge& edge : edges){
+        block.offsets[(edge.from - (blockIndex << blockShift)) + 1]++;
+      }
+      for(int i = 0; i < blockSize; i++){
+        block.offsets[i + 1] += block.offsets[i];
+      }
+      block.targets.resize(edges.size());
+      block.weights.resize(edges.size());
+      vector<int> next(block.offsets.begin(), block.offsets.end() - 1);
+      for(const Edge& edge : edges){
+        int slot = next[edge.from - (blockIndex << blockShift)]++;
+        block.targets[slot] = edge.to;
+        block.weights[slot] = edge.weight;
+      }
+      return block;
+    }
+
+    // Frees every retired version that no reader can still hold: all active
+    // readers announced an epoch at or after the one the version was retired in
+    void reclaim(){
+      uint64_t oldestActive = UINT64_MAX;
+      for(ReaderSlot& slot : slots){
+        uint64_t epoch = slot.epoch.load(memory_order_seq_cst);
+        if(epoch != 0){
+          oldestActive = min(oldestActive, epoch);
+        }
+      }
+      size_t kept = 0;
+      for(Retired& retired : retiredVersions){
+        if(retired.epoch <= oldestActive){
+          delete retired.graph;
+        }
+        else{
+          retiredVersions[kept++] = retired;
+        }
+      }
+      retiredVersions.resize(kept);
+    }
+};
+
+ReaderHandle::ReaderHandle(VersionedGraph& graph) : graph(graph), slot(-1){
+  for(int i = 0; i < VersionedGraph::maxReaders && slot < 0; i++){
+    bool expected = false;
+    if(graph.slots[i].inUse.compare_exchange_strong(expected, true, memory_order_acquire)){
+      slot = i;
+    }
+  }
+  if(slot < 0){
+    throw runtime_error("all " + to_string(VersionedGraph::maxReaders) + " reader slots are in use");
+  }
+}
+
+ReaderHandle::~ReaderHandle(){
+  graph.slots[slot].inUse.store(false, memory_order_release);
+}
+
+Snapshot::Snapshot(ReaderHandle& reader) : slot(reader.graph.slots[reader.slot].epoch){
+  // Announce first, then load: a writer that misses the announcement has
+  // already swapped, so this load sees its new version
+  VersionedGraph& graph = reader.graph;
+  slot.store(graph.globalEpoch.load(memory_order_seq_cst), memory_order_seq_cst);
+  pinned = graph.current.load(memory_order_seq_cst);
+}
+
+Snapshot::~Snapshot(){
+  slot.store(0, memory_order_release);
+}
+
+// Dijkstra's Algorithm on one pinned version
+// Returns: distance from start to destination, INT_MAX if unreachable
+int findShortestPath(const GraphVersion& graph, int start, int destination, vector<int>& distances){
+  distances.assign(graph.vertexCount, INT_MAX);
+  typedef pair<int, int> HeapEntry;
+  vector<HeapEntry> heap;
+  distances[start] = 0;
+  heap.push_back(HeapEntry(0, start));
+  while(!heap.empty()){
+    pop_heap(heap.begin(), heap.end(), greater<HeapEntry>());
+    HeapEntry top = heap.back();
+    heap.pop_back();
+    if(top.first > distances[top.second]){
+      continue;
+    }
+    if(top.second == destination){
+      return top.first;
+    }
+    const AdjacencyBlock& block = graph.blockOf(top.second);
+    int local = top.second & (blockSize - 1);
+    for(int e = block.offsets[local]; e < block.offsets[local + 1]; e++){
+      int newDistance = top.first + block.weights[e];
+      if(newDistance < distances[block.targets[e]]){
+        distances[block.targets[e]] = newDistance;
+        heap.push_back(HeapEntry(newDistance, block.targets[e]));
+        push_heap(heap.begin(), heap.end(), greater<HeapEntry>());
+      }
+    }
+  }
+  return INT_MAX;
+}
+
+// Road-like side x side grid with random weights in [1, 100] in both directions
+vector<Edge> buildGridEdges(int side, unsigned seed){
+  mt19937 rng(seed);
+  uniform_int_distribution<int> weight(1, 100);
+  vector<Edge> edges;
+  for(int row = 0; row < side; row++){
+    for(int col = 0; col < side; col++){
+      int here = row * side + col;
+      if(col + 1 < side){
+        int w = weight(rng);
+        edges.push_back({here, here + 1, w});
+        edges.push_back({here + 1, here, w});
+      }
+      if(row + 1 < side){
+        int w = weight(rng);
+        edges.push_back({here, here + side, w});
+        edges.push_back({here + side, here, w});
+      }
+    }
+  }
+  return edges;
+}
+
+// Runs query threads for a fixed time, optionally with a writer publishing
+// batches of updates the whole time, and prints query latency percentiles
+void measureLatency(VersionedGraph& graph, int n, const vector<Edge>& edges, int readers, bool withWriter, int seconds){
+  atomic<bool> stop(false);
+  vector<vector<double> > latencies(readers);
+  vector<thread> threads;
+
+  for(int r = 0; r < readers; r++){
+    threads.push_back(thread([&, r](){
+      ReaderHandle reader(graph);
+      mt19937 rng(r);
+      vector<int> distances;
+      while(!stop.load(memory_order_relaxed)){
+        int from = rng() % n, to = rng() % n;
+        auto t0 = chrono::steady_clock::now();
+        {
+          Snapshot snapshot(reader);
+          findShortestPath(snapshot.graph(), from, to, distances);
+        }
+        latencies[r].push_back(chrono::duration<double>(chrono::steady_clock::now() - t0).count() * 1000);
+      }
+    }));
+  }
+
+  uint64_t published = 0;
+  if(withWriter){
+    threads.push_back(thread([&](){
+      mt19937 rng(99);
+      while(!stop.load(memory_order_relaxed)){
+        vector<WeightUpdate> updates;
+        for(int i = 0; i < 100; i++){
+          const Edge& edge = edges[rng() % edges.size()];
+          updates.push_back({edge.from, edge.to, (int)(rng() % 100) + 1});
+        }
+        graph.publish(updates);
+        published++;
+      }
+    }));
+  }
+
+  this_thread::sleep_for(chrono::seconds(seconds));
+  stop.store(true);
+  for(thread& t : threads){
+    t.join();
+  }
+
+  vector<double> all;
+  for(vector<double>& list : latencies){
+    all.insert(all.end(), list.begin(), list.end());
+  }
+  sort(all.begin(), all.end());
+  if(all.empty()){
+    return;
+  }
+  cout << (withWriter ? "  with writer:    " : "  without writer: ") << all.size() << " queries, p50 "
+       << all[all.size() / 2] << " ms, p99 " << all[all.size() * 99 / 100] << " ms, max " << all.back() << " ms";
+  if(withWriter){
+    cout << ", " << published << " versions published";
+  }
+  cout << endl;
+}
+
+// Usage: ./snapshot_routing bench [side] [readers] [seconds]
+int main(int argc, char* argv[]){
+
+  if(argc > 1 && string(argv[1]) == "bench"){
+    int side = argc > 2 ? stoi(argv[2]) : 300;
+    int readers = argc > 3 ? stoi(argv[3]) : 4;
+    int seconds = argc > 4 ? stoi(argv[4]) : 2;
+    vector<Edge> edges = buildGridEdges(side, 42);
+    VersionedGraph graph(side * side, edges);
+    cout << "Grid " << side << "x" << side << ", " << readers << " query threads" << endl;
+    measureLatency(graph, side * side, edges, readers, false, seconds);
+    measureLatency(graph, side * side, edges, readers, true, seconds);
+    cout << "  versions still waiting for reclamation: " << graph.pendingReclamation() << endl;
+    return 0;
+  }
+
+  // Graph structure (ids: A=0, B=1, C=2, D=3):
+  //   A --10--> B --15--> D
+  //    \                 /
+  //     5----> C --20---
+  VersionedGraph graph(4, {{0, 1, 10}, {0, 2, 5}, {1, 3, 15}, {2, 3, 20}});
+  vector<int> distances;
+
+  // A reader pins version 1, then a writer publishes a jam on C -> D
+  ReaderHandle reader(graph), otherReader(graph);
+  Snapshot before(reader);
+  graph.publish({{2, 3, 40}, {1, 3, 30}});
+  cout << "Pinned version, A to D: " << findShortestPath(before.graph(), 0, 3, distances) << endl;
+  cout << "Retired versions held by readers: " << graph.pendingReclamation() << endl;
+
+  {
+    Snapshot after(otherReader);
+    cout << "Version " << after.graph().version << ", A to D: " << findShortestPath(after.graph(), 0, 3, distances) << endl;
+  }
+  return 0;
+}
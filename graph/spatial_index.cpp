@@ -0,0 +1,315 @@
+#include<iostream>
+#include<vector>
+#include<string>
+#include<algorithm>
+#include<numeric>
+#include<cmath>
+#include<cfloat>
+#include<chrono>
+#include<random>
+using namespace std;
+
+// Snapping coordinates to the nearest place
+//
+// Requests arrive as latitude/longitude and must be mapped to a vertex.
+// Without an index that is a scan over every place. SpatialIndex is a
+// static k-d tree built in bulk from the per-vertex coordinates and stored
+// implicitly in one array: the subtree over positions [lo, hi) splits at
+// mid = (lo + hi) / 2, the point at mid is the splitting point, the left
+// half is [lo, mid) and the right half is [mid + 1, hi). There are no child
+// pointers, and ranges of at most leafSize points are scanned directly.
+//
+// Coordinates are projected once onto a local plane (equirectangular around
+// the mean position, in metres), which is accurate enough for snapping
+// within a city or region. Projected points are stored as float pairs
+// relative to the mean, 8 bytes each, with vertex ids in a separate array
+// that is only read when a point improves the result.
+
+// Position of a place; vertices without one are left out of the index
+struct Coordinate{
+  double latitude;
+  double longitude;
+};
+
+// One nearest-neighbour result
+struct Neighbour{
+  int vertex;
+  double distance;  // Metres on the projected plane
+};
+
+class SpatialIndex{
+  public:
+    // Builds the tree over coordinates[v] for every vertex v with hasCoordinate[v]
+    // (an empty hasCoordinate means all vertices have one)
+    SpatialIndex(const vector<Coordinate>& coordinates, const vector<bool>& hasCoordinate = vector<bool>()){
+      double latitudeSum = 0, longitudeSum = 0;
+      for(size_t v = 0; v < coordinates.size(); v++){
+        if(hasCoordinate.empty() || hasCoordinate[v]){
+          latitudeSum += coordinates[v].latitude;
+          longitudeSum += coordinates[v].longitude;
+          vertices.push_back((int)v);
+        }
+      }
+      size_t count = vertices.size();
+      center = count == 0 ? Coordinate{0, 0} : Coordinate{latitudeSum / count, longitudeSum / count};
+      metresPerLongitude = metresPerDegree * cos(center.latitude * M_PI / 180);
+
+      // Build on (point, vertex) pairs, then split them into the two arrays
+      vector<pair<Point, int> > items(count);
+      for(size_t i = 0; i < count; i++){
+        items[i] = make_pair(project(coordinates[vertices[i]]), vertices[i]);
+      }
+      splitAxis.assign(count, 0);
+      build(items, 0, count);
+      points.resize(count);
+      for(size_t i = 0; i < count; i++){
+        points[i] = items[i].first;
+        vertices[i] = items[i].second;
+      }
+    }
+
+    // Closest indexed vertex to the coordinate; vertex -1 if the index is empty
+    Neighbour nearest(const Coordinate& coordinate) const{
+      Point query = project(coordinate);
+      Neighbour best = {-1, DBL_MAX};  // distance holds the squared distance until the end
+      searchNearest(0, points.size(), query, best);
+      best.distance = sqrt(best.distance);
+      return best;
+    }
+
+    // Up to k closest vertices, nearest first
+    vector<Neighbour> nearest(const Coordinate& coordinate, int k) const{
+      Point query = project(coordinate);
+      vector<Neighbour> heap;  // Max-heap on squared distance, at most k entries
+      if(k > 0){
+        heap.reserve(k);
+        searchNearest(0, points.size(), query, k, heap);
+      }
+      sort_heap(heap.begin(), heap.end(), farther);
+      for(Neighbour& neighbour : heap){
+        neighbour.distance = sqrt(neighbour.distance);
+      }
+      return heap;
+    }
+
+    size_t size() const{
+      return points.size();
+    }
+
+  private:
+    static constexpr double metresPerDegree = 111320.0;
+    static const size_t leafSize = 8;
+
+    // Metres east and north of the center
+    struct Point{
+      float x;
+      float y;
+    };
+
+    vector<Point> points;              // Tree order
+    vector<int> vertices;              // Vertex of each point
+    vector<unsigned char> splitAxis;   // At each splitting position: 0 = x, 1 = y
+    Coordinate center;
+    double metresPerLongitude;
+
+    Point project(const Coordinate& coordinate) const{
+      return {(float)((coordinate.longitude - center.longitude) * metresPerLongitude),
+              (float)((coordinate.latitude - center.latitude) * metresPerDegree)};
+    }
+
+    static float coordinateOf(const Point& point, int axis){
+      return axis == 0 ? point.x : point.y;
+    }
+
+    static double squaredDistance(const Point& a, const Point& b){
+      double dx = (double)a.x - b.x, dy = (double)a.y - b.y;
+      return dx * dx + dy * dy;
+    }
+
+    static bool farther(const Neighbour& a, const Neighbour& b){
+      return a.distance < b.distance;
+    }
+
+    // Splits [lo, hi) at its median along the wider side of its bounding box
+    void build(vector<pair<Point, int> >& items, size_t lo, size_t hi){
+      if(hi - lo <= leafSize){
+        return;
+      }
+      float minX = FLT_MAX, maxX = -FLT_MAX, minY = FLT_MAX, maxY = -FLT_MAX;
+      for(size_t i = lo; i < hi; i++){
+        minX = min(minX, items[i].first.x);
+        maxX = max(maxX, items[i].first.x);
+        minY = min(minY, items[i].first.y);
+        maxY = max(maxY, items[i].first.y);
+      }
+      int axis = maxX - minX >= maxY - minY ? 0 : 1;
+      size_t mid = (lo + hi) / 2;
+      nth_element(items.begin() + lo, items.begin() + mid, items.begin() + hi,
+                  [axis](const pair<Point, int>& a, const pair<Point, int>& b){
+        return coordinateOf(a.first, axis) < coordinateOf(b.first, axis);
+      });
+      splitAxis[mid] = (unsigned char)axis;
+      build(items, lo, mid);
+      build(items, mid + 1, hi);
+    }
+
+    void searchNearest(size_t lo, size_t hi, const Point& query, Neighbour& best) const{
+      if(hi - lo <= leafSize){
+        for(size_t i = lo; i < hi; i++){
+          double distance = squaredDistance(points[i], query);
+          if(distance < best.distance){
+            best = {vertices[i], distance};
+          }
+        }
+        return;
+      }
+      size_t mid = (lo + hi) / 2;
+      double distance = squaredDistance(points[mid], query);
+      if(distance < best.distance){
+        best = {vertices[mid], distance};
+      }
+      // Near side first; the far side only if the splitting line is closer
+      // than the best point so far
+      double offset = (double)coordinateOf(query, splitAxis[mid]) - coordinateOf(points[mid], splitAxis[mid]);
+      if(offset < 0){
+        searchNearest(lo, mid, query, best);
+        if(offset * offset < best.distance){
+          searchNearest(mid + 1, hi, query, best);
+        }
+      }
+      else{
+        searchNearest(mid + 1, hi, query, best);
+        if(offset * offset < best.distance){
+          searchNearest(lo, mid, query, best);
+        }
+      }
+    }
+
+    // k-nearest variant: the heap holds the k best so far, worst on top
+    void consider(size_t i, const Point& query, int k, vector<Neighbour>& heap) const{
+      double distance = squaredDistance(points[i], query);
+      if((int)heap.size() < k){
+        heap.push_back({vertices[i], distance});
+        push_heap(heap.begin(), heap.end(), farther);
+      }
+      else if(distance < heap.front().distance){
+        pop_heap(heap.begin(), heap.end(), farther);
+        heap.back() = {vertices[i], distance};
+        push_heap(heap.begin(), heap.end(), farther);
+      }
+    }
+
+    void searchNearest(size_t lo, size_t hi, const Point& query, int k, vector<Neighbour>& heap) const{
+      if(hi - lo <= leafSize){
+        for(size_t i = lo; i < hi; i++){
+          consider(i, query, k, heap);
+        }
+        return;
+      }
+      size_t mid = (lo + hi) / 2;
+      consider(mid, query, k, heap);
+      double offset = (double)coordinateOf(query, splitAxis[mid]) - coordinateOf(points[mid], splitAxis[mid]);
+      size_t nearLo = offset < 0 ? lo : mid + 1, nearHi = offset < 0 ? mid : hi;
+      size_t farLo = offset < 0 ? mid + 1 : lo, farHi = offset < 0 ? hi : mid;
+      searchNearest(nearLo, nearHi, query, k, heap);
+      if((int)heap.size() < k || offset * offset < heap.front().distance){
+        searchNearest(farLo, farHi, query, k, heap);
+      }
+    }
+};
+
+// Reference: distance to every vertex on the same plane as the index
+// (equirectangular around the mean latitude)
+Neighbour nearestByScan(const vector<Coordinate>& coordinates, const Coordinate& query){
+  double latitudeSum = 0;
+  for(const Coordinate& coordinate : coordinates){
+    latitudeSum += coordinate.latitude;
+  }
+  double metresPerLongitude = 111320.0 * cos(latitudeSum / coordinates.size() * M_PI / 180);
+  Neighbour best = {-1, DBL_MAX};
+  for(size_t v = 0; v < coordinates.size(); v++){
+    double dx = (coordinates[v].longitude - query.longitude) * metresPerLongitude;
+    double dy = (coordinates[v].latitude - query.latitude) * 111320.0;
+    if(dx * dx + dy * dy < best.distance){
+      best = {(int)v, dx * dx + dy * dy};
+    }
+  }
+  best.distance = sqrt(best.distance);
+  return best;
+}
+
+// Random places in a 50 x 50 km box, as a stand-in for a city's vertices
+vector<Coordinate> generateCoordinates(int count, unsigned seed){
+  mt19937 rng(seed);
+  uniform_real_distribution<double> latitude(52.3, 52.75), longitude(13.0, 13.75);
+  vector<Coordinate> coordinates(count);
+  for(Coordinate& coordinate : coordinates){
+    coordinate = {latitude(rng), longitude(rng)};
+  }
+  return coordinates;
+}
+
+// Build time and nearest / 8-nearest latency, checked against a full scan
+// Usage: ./spatial_index bench [places] [queries]
+void runBenchmark(int count, int queries){
+  vector<Coordinate> coordinates = generateCoordinates(count, 42);
+  vector<Coordinate> targets = generateCoordinates(queries, 7);
+
+  auto t0 = chrono::steady_clock::now();
+  SpatialIndex index(coordinates);
+  double buildSeconds = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+
+  long long checksum = 0;
+  auto t1 = chrono::steady_clock::now();
+  for(const Coordinate& target : targets){
+    checksum += index.nearest(target).vertex;
+  }
+  double nearestSeconds = chrono::duration<double>(chrono::steady_clock::now() - t1).count();
+
+  auto t2 = chrono::steady_clock::now();
+  for(const Coordinate& target : targets){
+    checksum += index.nearest(target, 8).size();
+  }
+  double kNearestSeconds = chrono::duration<double>(chrono::steady_clock::now() - t2).count();
+
+  int checked = min(queries, 200), bad = 0;
+  auto t3 = chrono::steady_clock::now();
+  for(int i = 0; i < checked; i++){
+    // Compared by distance: equally distant places may come back in either
+    // order, and the index rounds projected positions to float
+    bad += fabs(index.nearest(targets[i]).distance - nearestByScan(coordinates, targets[i]).distance) > 0.01;
+  }
+  double scanSeconds = chrono::duration<double>(chrono::steady_clock::now() - t3).count();
+
+  cout << count << " places: build " << buildSeconds * 1000 << " ms, nearest "
+       << nearestSeconds / queries * 1e9 << " ns, 8-nearest " << kNearestSeconds / queries * 1e9
+       << " ns, full scan " << scanSeconds / checked * 1e9 << " ns" << (bad == 0 ? "" : " (MISMATCH)")
+       << " [checksum " << checksum << "]" << endl;
+}
+
+// Main function: snaps a few coordinates to the small example map
+int main(int argc, char* argv[]){
+
+  if(argc > 1 && string(argv[1]) == "bench"){
+    int count = argc > 2 ? stoi(argv[2]) : 1000000;
+    int queries = argc > 3 ? stoi(argv[3]) : 1000000;
+    runBenchmark(count, queries);
+    return 0;
+  }
+
+  // Places A, B, C, D (ids 0-3); D has no known position
+  vector<string> names = {"A", "B", "C", "D"};
+  vector<Coordinate> coordinates = {{52.52, 13.40}, {52.51, 13.45}, {52.50, 13.38}, {0, 0}};
+  vector<bool> hasCoordinate = {true, true, true, false};
+  SpatialIndex index(coordinates, hasCoordinate);
+
+  Coordinate request = {52.512, 13.44};
+  Neighbour closest = index.nearest(request);
+  cout << "Nearest place: " << names[closest.vertex] << " (" << (int)closest.distance << " m)" << endl;
+  cout << "Two nearest:";
+  for(const Neighbour& neighbour : index.nearest(request, 2)){
+    cout << " " << names[neighbour.vertex] << " (" << (int)neighbour.distance << " m)";
+  }
+  cout << endl;
+  return 0;
+}
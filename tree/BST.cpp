@@ -1,22 +1,26 @@
 /**
  * @file bst.c
- * @brief Binary Search Tree (BST) Implementation in C
+ * @brief Self-balancing (AVL) Binary Search Tree Implementation in C
  * 
- * This program implements a Binary Search Tree with iterative insertion,
- * inorder traversal, and proper memory management. It demonstrates fundamental
- * BST operations while handling edge cases like duplicate values and memory
- * allocation failures.
+ * This program implements an AVL tree: a Binary Search Tree that stores the
+ * height of every subtree and rotates after each insertion and deletion so
+ * that the heights of sibling subtrees never differ by more than one. The
+ * tree height therefore stays below 1.44 * log2(n + 2) for any insertion
+ * order, including the sorted and nearly sorted orders that turn a plain BST
+ * into a linked list.
  * 
  * @author [Your Name]
  * @date 2025-10-31
  * @version 1.0
  * 
  * Features:
- * - Iterative insertion (avoids stack overflow from deep recursion)
+ * - Balanced insertion and deletion with single and double rotations
+ * - Search in O(log n) worst case
  * - Duplicate value detection and rejection
  * - Robust input validation
  * - Memory leak prevention with proper cleanup
  * - Inorder traversal for sorted output
+ * - Benchmark against the unbalanced insert on sorted keys
  * 
  * Compilation:
  *   gcc -Wall -Wextra -O2 bst.c -o bst
@@ -24,6 +28,8 @@
  * Usage:
  *   ./bst
  *   Enter the number of nodes, then input integer values
+ *   ./bst bench [n]
+ *   Insert and search n sorted keys in the AVL tree and the plain BST
  * 
  * Example:
  *   Enter number of nodes to insert in BST: 5
@@ -34,6 +40,8 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
 /**
  * @struct Node
@@ -43,11 +51,13 @@
  * - An integer data value
  * - A pointer to the left child (values less than current node)
  * - A pointer to the right child (values greater than current node)
+ * - The height of the subtree rooted at the node (a leaf has height 1)
  */
 struct Node {
     int data;              /**< Integer value stored in the node */
     struct Node* left;     /**< Pointer to left subtree (smaller values) */
     struct Node* right;    /**< Pointer to right subtree (larger values) */
+    int height;            /**< Height of this subtree, used for balancing */
 };
 
 /**
@@ -71,15 +81,198 @@ struct Node* createNode(int value) {
     newNode->data = value;
     newNode->left = NULL;
     newNode->right = NULL;
+    newNode->height = 1;
     return newNode;
 }
 
 /**
- * @brief Inserts a new value into the BST using iterative approach
+ * @brief Returns the height of a subtree
+ * 
+ * @param node Root of the subtree (may be NULL)
+ * @return Number of nodes on the longest root-to-leaf path, 0 for NULL
+ * 
+ * Time Complexity: O(1) - the height is stored in the node
+ */
+int height(struct Node* node) {
+    return node == NULL ? 0 : node->height;
+}
+
+/**
+ * @brief Recomputes a node's height from its children's heights
+ * 
+ * @param node Node whose children are already up to date
+ */
+static void updateHeight(struct Node* node) {
+    int left = height(node->left);
+    int right = height(node->right);
+    node->height = (left > right ? left : right) + 1;
+}
+
+/**
+ * @brief Rotates the subtree rooted at node to the right
+ * 
+ *         node             pivot
+ *        /    \            /    \
+ *     pivot    C   =>     A    node
+ *     /   \                    /   \
+ *    A     B                  B     C
+ * 
+ * @param node Root of the subtree; must have a left child
+ * @return The new root of the subtree (the former left child)
+ */
+static struct Node* rotateRight(struct Node* node) {
+    struct Node* pivot = node->left;
+    node->left = pivot->right;
+    pivot->right = node;
+    updateHeight(node);
+    updateHeight(pivot);
+    return pivot;
+}
+
+/**
+ * @brief Rotates the subtree rooted at node to the left (mirror of rotateRight)
+ * 
+ * @param node Root of the subtree; must have a right child
+ * @return The new root of the subtree (the former right child)
+ */
+static struct Node* rotateLeft(struct Node* node) {
+    struct Node* pivot = node->right;
+    node->right = pivot->left;
+    pivot->left = node;
+    updateHeight(node);
+    updateHeight(pivot);
+    return pivot;
+}
+
+/**
+ * @brief Restores the AVL property at a node after one of its subtrees changed
+ * 
+ * The children of node are balanced and their heights differ by at most two.
+ * If the taller child leans the other way (left-right or right-left case) it
+ * is rotated first, so a single rotation at node then balances the subtree.
+ * 
+ * @param node Root of the subtree to rebalance
+ * @return The new root of the subtree
+ */
+static struct Node* rebalance(struct Node* node) {
+    updateHeight(node);
+    int balance = height(node->left) - height(node->right);
+    if (balance > 1) {
+        if (height(node->left->left) < height(node->left->right))
+            node->left = rotateLeft(node->left);
+        return rotateRight(node);
+    }
+    if (balance < -1) {
+        if (height(node->right->right) < height(node->right->left))
+            node->right = rotateRight(node->right);
+        return rotateLeft(node);
+    }
+    return node;
+}
+
+/**
+ * @brief Inserts a new value into the BST and rebalances it
+ * 
+ * Descends to the insertion point like a plain BST insert, then rebalances
+ * every node on the way back up. Recursion is safe here: the depth is the
+ * tree height, which the balancing keeps logarithmic.
+ * 
+ * BST Property Maintained:
+ * - All values in left subtree < node value
+ * - All values in right subtree > node value
+ * - Sibling subtree heights differ by at most one
+ * 
+ * @param root Pointer to the root node of the BST
+ * @param value The integer value to insert
+ * @return Pointer to the root of the modified BST (may be a different node)
+ * 
+ * @note Duplicate values are not inserted; a message is printed instead
+ * @note If memory allocation fails, the tree remains unchanged
+ * 
+ * Time Complexity: O(log n)
+ * Space Complexity: O(log n) recursion stack
+ */
+struct Node* insert(struct Node* root, int value) {
+    if (root == NULL) {
+        return createNode(value);
+    }
+    
+    if (value < root->data)
+        root->left = insert(root->left, value);
+    else if (value > root->data)
+        root->right = insert(root->right, value);
+    else {
+        /* Duplicate value — do not insert */
+        printf("Value %d already exists in BST. Skipping duplicate.\n", value);
+        return root;
+    }
+    
+    return rebalance(root);
+}
+
+/**
+ * @brief Finds the node holding a value
+ * 
+ * @param root Pointer to the root node of the BST
+ * @param value The integer value to look for
+ * @return Pointer to the node holding value, or NULL if it is not in the tree
+ * 
+ * Time Complexity: O(log n)
+ * Space Complexity: O(1)
+ */
+struct Node* search(struct Node* root, int value) {
+    while (root != NULL && root->data != value)
+        root = value < root->data ? root->left : root->right;
+    return root;
+}
+
+/**
+ * @brief Removes a value from the BST and rebalances it
+ * 
+ * A node with at most one child is replaced by that child. A node with two
+ * children takes the value of its inorder successor (the smallest value in
+ * its right subtree), and the successor is erased from the right subtree
+ * instead. Every node on the path back up is rebalanced.
+ * 
+ * @param root Pointer to the root node of the BST
+ * @param value The integer value to remove
+ * @return Pointer to the root of the modified BST (NULL if it became empty)
+ * 
+ * @note Erasing a value that is not in the tree leaves the tree unchanged
+ * 
+ * Time Complexity: O(log n)
+ * Space Complexity: O(log n) recursion stack
+ */
+struct Node* erase(struct Node* root, int value) {
+    if (root == NULL) return NULL;
+    
+    if (value < root->data)
+        root->left = erase(root->left, value);
+    else if (value > root->data)
+        root->right = erase(root->right, value);
+    else if (root->left == NULL || root->right == NULL) {
+        struct Node* child = root->left != NULL ? root->left : root->right;
+        free(root);
+        return child;
+    }
+    else {
+        struct Node* successor = root->right;
+        while (successor->left != NULL)
+            successor = successor->left;
+        root->data = successor->data;
+        root->right = erase(root->right, successor->data);
+    }
+    
+    return rebalance(root);
+}
+
+/**
+ * @brief Inserts a value without balancing (the plain BST insert)
  * 
  * Iteratively traverses the tree to find the correct position for insertion.
  * This approach avoids potential stack overflow issues with deeply unbalanced
- * trees that could occur with recursive insertion.
+ * trees that could occur with recursive insertion. Kept as the baseline for
+ * the benchmark: sorted input makes every insert walk the whole tree.
  * 
  * BST Property Maintained:
  * - All values in left subtree < node value
@@ -92,10 +285,10 @@ struct Node* createNode(int value) {
  * @note Duplicate values are not inserted; a message is printed instead
  * @note If memory allocation fails, the tree remains unchanged
  * 
- * Time Complexity: O(h) where h is the height of the tree
+ * Time Complexity: O(h) where h is the height of the tree, O(n) for sorted input
  * Space Complexity: O(1) - iterative approach uses constant space
  */
-struct Node* insert(struct Node* root, int value) {
+struct Node* insertUnbalanced(struct Node* root, int value) {
     /* Handle empty tree case */
     if (root == NULL) {
         return createNode(value);
@@ -176,9 +369,66 @@ void freeTree(struct Node* root) {
     free(root);
 }
 
+/**
+ * @brief Inserts and searches n sorted keys in the AVL tree and the plain BST
+ * 
+ * Sorted input is the worst case for the plain BST: every key becomes the
+ * right child of the previous one, so the tree is a linked list of height n
+ * and inserting all keys takes O(n^2). The AVL tree stays at height
+ * O(log n). Prints the height and the insert and search times of both.
+ * 
+ * @param n Number of keys to insert (0 .. n-1 in ascending order)
+ * 
+ * @note freeTree recurses to the tree height, so n is kept to a size whose
+ *       linked-list tree still fits on the stack
+ */
+void runBenchmark(int n) {
+    struct Node* balanced = NULL;
+    struct Node* plain = NULL;
+    clock_t start;
+    double seconds[4];
+    int found[2] = {0, 0};
+    
+    start = clock();
+    for (int i = 0; i < n; i++)
+        balanced = insert(balanced, i);
+    seconds[0] = (double)(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    for (int i = 0; i < n; i++)
+        found[0] += search(balanced, i) != NULL;
+    seconds[1] = (double)(clock() - start) / CLOCKS_PER_SEC;
+    
+    start = clock();
+    for (int i = 0; i < n; i++)
+        plain = insertUnbalanced(plain, i);
+    seconds[2] = (double)(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    for (int i = 0; i < n; i++)
+        found[1] += search(plain, i) != NULL;
+    seconds[3] = (double)(clock() - start) / CLOCKS_PER_SEC;
+    
+    printf("%d sorted keys\n", n);
+    printf("  AVL tree:  height %d, insert %.2f ms, search %.2f ms\n",
+           height(balanced), seconds[0] * 1000, seconds[1] * 1000);
+    /* insertUnbalanced does not maintain heights; sorted keys make a right chain */
+    int plainHeight = 0;
+    for (struct Node* node = plain; node != NULL; node = node->right)
+        plainHeight++;
+    printf("  plain BST: height %d, insert %.2f ms, search %.2f ms\n",
+           plainHeight, seconds[2] * 1000, seconds[3] * 1000);
+    if (found[0] != n || found[1] != n)
+        printf("  (MISMATCH: %d and %d of %d keys found)\n", found[0], found[1], n);
+    
+    freeTree(balanced);
+    freeTree(plain);
+}
+
 /**
  * @brief Main function - Entry point of the program
  * 
+ * With the argument "bench" (and an optional key count) runs runBenchmark
+ * instead of reading values.
+ * 
  * Workflow:
  * 1. Prompts user for number of nodes to insert
  * 2. Validates input (must be positive integer)
@@ -203,10 +453,15 @@ void freeTree(struct Node* root) {
  * Inorder Traversal of Constructed BST: 20 30 40 50 60 70 80
  * @endcode
  */
-int main(void) {
+int main(int argc, char* argv[]) {
     struct Node* root = NULL;
     int n;
     
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        runBenchmark(argc > 2 ? atoi(argv[2]) : 20000);
+        return 0;
+    }
+    
     /* Get number of nodes from user */
     printf("Enter number of nodes to insert in BST: ");
     if (scanf("%d", &n) != 1 || n <= 0) {
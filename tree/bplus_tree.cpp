@@ -0,0 +1,600 @@
+/**
+ * B+ Tree: a cache-conscious ordered index for integer keys
+ *
+ * A binary search tree touches one node, usually one cache miss, per level:
+ * about log2(n) misses per lookup, 23+ for ten million keys. A B+ tree puts
+ * many keys in each node so a lookup only needs log_B(n) node visits:
+ *   - every node is 256 bytes (four cache lines) and 64-byte aligned
+ *   - keys are stored contiguously at the start of the node, so the search
+ *     inside a node is a short, vectorisable scan over at most 31 ints
+ *   - inner nodes hold up to 31 separator keys and 32 child indices
+ *   - leaves hold up to 31 keys and their values, and link to the next leaf,
+ *     so ordered iteration and range scans walk leaves sequentially without
+ *     going back up the tree
+ * Nodes live in two pools (vectors) and refer to each other by 32-bit index,
+ * which keeps the fanout high; freed nodes are reused.
+ *
+ * Every node but the root is at least half full: insert splits a full node
+ * in two, erase borrows from a sibling or merges with it.
+ *
+ * Time Complexity: O(log n) for insert, find and erase, O(log n + k) to scan k keys
+ * Space Complexity: O(n), at least half of every node is used
+ */
+
+#include <iostream>
+#include <vector>
+#include <set>
+#include <string>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+using namespace std;
+
+const int innerCapacity = 31;  // Separator keys per inner node
+const int leafCapacity = 31;   // Keys per leaf
+const uint32_t noNode = UINT32_MAX;
+
+// 4 + 31 * 4 + 32 * 4 = 256 bytes
+struct alignas(64) InnerNode {
+    int count;                          // Number of keys; count + 1 children
+    int keys[innerCapacity];            // children[i] holds keys in [keys[i - 1], keys[i])
+    uint32_t children[innerCapacity + 1];
+};
+
+// 4 + 4 + 31 * 4 + 31 * 4 = 256 bytes
+struct alignas(64) LeafNode {
+    int count;
+    uint32_t next;                      // Next leaf in key order, noNode for the last
+    int keys[leafCapacity];
+    int values[leafCapacity];
+};
+
+static_assert(sizeof(InnerNode) == 256 && sizeof(LeafNode) == 256, "nodes must be four cache lines");
+
+class BPlusTree {
+public:
+    /**
+     * Position in the tree for ordered iteration:
+     *   for (BPlusTree::Cursor c = tree.lowerBound(k); c.valid(); c.next())
+     */
+    struct Cursor {
+        const BPlusTree* tree;
+        uint32_t leaf;
+        int slot;
+
+        bool valid() const { return leaf != noNode; }
+        int key() const { return tree->leaves[leaf].keys[slot]; }
+        int value() const { return tree->leaves[leaf].values[slot]; }
+
+        void next() {
+            if (++slot == tree->leaves[leaf].count) {
+                leaf = tree->leaves[leaf].next;
+                slot = 0;
+            }
+        }
+    };
+
+    BPlusTree() : root(newLeaf()), height(1), size_(0) {}
+
+    size_t size() const { return size_; }
+
+    // Levels from the root to the leaves (node visits per lookup)
+    int levels() const { return height; }
+
+    size_t memoryBytes() const {
+        return inners.capacity() * sizeof(InnerNode) + leaves.capacity() * sizeof(LeafNode);
+    }
+
+    /**
+     * Inserts key with value, or replaces the value if key is present
+     * @return true if the key was new
+     */
+    bool insert(int key, int value) {
+        descend(key);
+        LeafNode& leaf = leaves[pathLeaf];
+        int slot = lowerSlot(leaf.keys, leaf.count, key);
+        if (slot < leaf.count && leaf.keys[slot] == key) {
+            leaf.values[slot] = value;
+            return false;
+        }
+        size_++;
+        if (leaf.count < leafCapacity) {
+            insertIntoLeaf(pathLeaf, slot, key, value);
+            return true;
+        }
+
+        // Split the full leaf: the upper half moves to a new right sibling
+        uint32_t left = pathLeaf;
+        uint32_t right = newLeaf();  // May reallocate the pool; index again below
+        int half = (leafCapacity + 1) / 2;
+        LeafNode& l = leaves[left];
+        LeafNode& r = leaves[right];
+        r.count = l.count - half;
+        copy(l.keys + half, l.keys + l.count, r.keys);
+        copy(l.values + half, l.values + l.count, r.values);
+        l.count = half;
+        r.next = l.next;
+        l.next = right;
+        if (slot <= half) {
+            insertIntoLeaf(left, slot, key, value);
+        }
+        else {
+            insertIntoLeaf(right, slot - half, key, value);
+        }
+        insertIntoParent((int)path.size() - 1, leaves[right].keys[0], right);
+        return true;
+    }
+
+    /**
+     * @return the value stored for key, or nullptr if key is absent
+     */
+    const int* find(int key) const {
+        uint32_t node = root;
+        for (int level = 1; level < height; level++) {
+            const InnerNode& inner = inners[node];
+            node = inner.children[upperSlot(inner.keys, inner.count, key)];
+        }
+        const LeafNode& leaf = leaves[node];
+        int slot = lowerSlot(leaf.keys, leaf.count, key);
+        return slot < leaf.count && leaf.keys[slot] == key ? &leaf.values[slot] : nullptr;
+    }
+
+    /**
+     * Removes key if present
+     * @return true if the key was removed
+     */
+    bool erase(int key) {
+        descend(key);
+        LeafNode& leaf = leaves[pathLeaf];
+        int slot = lowerSlot(leaf.keys, leaf.count, key);
+        if (slot == leaf.count || leaf.keys[slot] != key) {
+            return false;
+        }
+        size_--;
+        copy(leaf.keys + slot + 1, leaf.keys + leaf.count, leaf.keys + slot);
+        copy(leaf.values + slot + 1, leaf.values + leaf.count, leaf.values + slot);
+        leaf.count--;
+        if (height > 1 && leaf.count < leafCapacity / 2) {
+            fixLeafUnderflow();
+        }
+        return true;
+    }
+
+    // First key in order
+    Cursor begin() const {
+        uint32_t node = root;
+        for (int level = 1; level < height; level++) {
+            node = inners[node].children[0];
+        }
+        return Cursor{this, leaves[node].count == 0 ? noNode : node, 0};
+    }
+
+    // First key not less than key
+    Cursor lowerBound(int key) const {
+        uint32_t node = root;
+        for (int level = 1; level < height; level++) {
+            const InnerNode& inner = inners[node];
+            node = inner.children[upperSlot(inner.keys, inner.count, key)];
+        }
+        Cursor cursor{this, node, lowerSlot(leaves[node].keys, leaves[node].count, key)};
+        if (cursor.slot == leaves[node].count) {
+            cursor.leaf = leaves[node].next;
+            cursor.slot = 0;
+        }
+        return cursor;
+    }
+
+    /**
+     * Calls visit(key, value) for every key in [from, to] in ascending order,
+     * walking the leaf chain with a plain loop over each leaf's arrays
+     */
+    template<typename Visit>
+    void scan(int from, int to, const Visit& visit) const {
+        Cursor start = lowerBound(from);
+        int slot = start.slot;
+        for (uint32_t node = start.leaf; node != noNode; node = leaves[node].next, slot = 0) {
+            const LeafNode& leaf = leaves[node];
+            for (; slot < leaf.count; slot++) {
+                if (leaf.keys[slot] > to) {
+                    return;
+                }
+                visit(leaf.keys[slot], leaf.values[slot]);
+            }
+        }
+    }
+
+private:
+    vector<InnerNode> inners;
+    vector<LeafNode> leaves;
+    vector<uint32_t> freeInners;
+    vector<uint32_t> freeLeaves;
+    uint32_t root;
+    int height;    // 1 when the root is a leaf
+    size_t size_;
+
+    // Inner nodes and child slots from the root to the leaf of the last descend
+    vector<pair<uint32_t, int> > path;
+    uint32_t pathLeaf;
+
+    // Number of keys < key, i.e. the first slot whose key is >= key; counting
+    // instead of breaking out lets the compiler vectorise the scan
+    static int lowerSlot(const int* keys, int count, int key) {
+        int slot = 0;
+        for (int i = 0; i < count; i++) {
+            slot += keys[i] < key;
+        }
+        return slot;
+    }
+
+    // Number of keys <= key, i.e. the child of an inner node that holds key
+    static int upperSlot(const int* keys, int count, int key) {
+        int slot = 0;
+        for (int i = 0; i < count; i++) {
+            slot += keys[i] <= key;
+        }
+        return slot;
+    }
+
+    uint32_t newLeaf() {
+        uint32_t index;
+        if (!freeLeaves.empty()) {
+            index = freeLeaves.back();
+            freeLeaves.pop_back();
+        }
+        else {
+            index = (uint32_t)leaves.size();
+            leaves.emplace_back();
+        }
+        leaves[index].count = 0;
+        leaves[index].next = noNode;
+        return index;
+    }
+
+    uint32_t newInner() {
+        uint32_t index;
+        if (!freeInners.empty()) {
+            index = freeInners.back();
+            freeInners.pop_back();
+        }
+        else {
+            index = (uint32_t)inners.size();
+            inners.emplace_back();
+        }
+        inners[index].count = 0;
+        return index;
+    }
+
+    // Records the root-to-leaf path for key in path and pathLeaf
+    void descend(int key) {
+        path.clear();
+        uint32_t node = root;
+        for (int level = 1; level < height; level++) {
+            const InnerNode& inner = inners[node];
+            int slot = upperSlot(inner.keys, inner.count, key);
+            path.push_back(make_pair(node, slot));
+            node = inner.children[slot];
+        }
+        pathLeaf = node;
+    }
+
+    void insertIntoLeaf(uint32_t index, int slot, int key, int value) {
+        LeafNode& leaf = leaves[index];
+        copy_backward(leaf.keys + slot, leaf.keys + leaf.count, leaf.keys + leaf.count + 1);
+        copy_backward(leaf.values + slot, leaf.values + leaf.count, leaf.values + leaf.count + 1);
+        leaf.keys[slot] = key;
+        leaf.values[slot] = value;
+        leaf.count++;
+    }
+
+    /**
+     * Adds separator key with its right child to the inner node at path[depth],
+     * just after the child that was split; splits that node too if it is full.
+     * depth -1 means the split node was the root.
+     */
+    void insertIntoParent(int depth, int key, uint32_t child) {
+        if (depth < 0) {
+            uint32_t newRoot = newInner();
+            InnerNode& top = inners[newRoot];
+            top.count = 1;
+            top.keys[0] = key;
+            top.children[0] = root;
+            top.children[1] = child;
+            root = newRoot;
+            height++;
+            return;
+        }
+
+        uint32_t index = path[depth].first;
+        int slot = path[depth].second;
+        InnerNode& node = inners[index];
+        if (node.count < innerCapacity) {
+            copy_backward(node.keys + slot, node.keys + node.count, node.keys + node.count + 1);
+            copy_backward(node.children + slot + 1, node.children + node.count + 1, node.children + node.count + 2);
+            node.keys[slot] = key;
+            node.children[slot + 1] = child;
+            node.count++;
+            return;
+        }
+
+        // Full: lay out all keys and children in order, keep the lower half,
+        // move the upper half to a new node and push the middle key up
+        int keys[innerCapacity + 1];
+        uint32_t children[innerCapacity + 2];
+        copy(node.keys, node.keys + slot, keys);
+        keys[slot] = key;
+        copy(node.keys + slot, node.keys + node.count, keys + slot + 1);
+        copy(node.children, node.children + slot + 1, children);
+        children[slot + 1] = child;
+        copy(node.children + slot + 1, node.children + node.count + 1, children + slot + 2);
+
+        uint32_t right = newInner();  // May reallocate the pool
+        InnerNode& l = inners[index];
+        InnerNode& r = inners[right];
+        int half = (innerCapacity + 1) / 2;
+        l.count = half;
+        copy(keys, keys + half, l.keys);
+        copy(children, children + half + 1, l.children);
+        r.count = innerCapacity - half;
+        copy(keys + half + 1, keys + innerCapacity + 1, r.keys);
+        copy(children + half + 1, children + innerCapacity + 2, r.children);
+        insertIntoParent(depth - 1, keys[half], right);
+    }
+
+    // Removes keys[slot] and children[slot + 1] from an inner node
+    static void removeFromInner(InnerNode& node, int slot) {
+        copy(node.keys + slot + 1, node.keys + node.count, node.keys + slot);
+        copy(node.children + slot + 2, node.children + node.count + 1, node.children + slot + 1);
+        node.count--;
+    }
+
+    // The leaf of the last descend has fewer than leafCapacity / 2 keys
+    void fixLeafUnderflow() {
+        InnerNode& parent = inners[path.back().first];
+        int slot = path.back().second;
+        LeafNode& leaf = leaves[pathLeaf];
+
+        if (slot > 0) {
+            LeafNode& left = leaves[parent.children[slot - 1]];
+            if (left.count > leafCapacity / 2) {
+                // Borrow the left sibling's largest key
+                copy_backward(leaf.keys, leaf.keys + leaf.count, leaf.keys + leaf.count + 1);
+                copy_backward(leaf.values, leaf.values + leaf.count, leaf.values + leaf.count + 1);
+                left.count--;
+                leaf.keys[0] = left.keys[left.count];
+                leaf.values[0] = left.values[left.count];
+                leaf.count++;
+                parent.keys[slot - 1] = leaf.keys[0];
+                return;
+            }
+        }
+        if (slot < parent.count) {
+            LeafNode& right = leaves[parent.children[slot + 1]];
+            if (right.count > leafCapacity / 2) {
+                // Borrow the right sibling's smallest key
+                leaf.keys[leaf.count] = right.keys[0];
+                leaf.values[leaf.count] = right.values[0];
+                leaf.count++;
+                copy(right.keys + 1, right.keys + right.count, right.keys);
+                copy(right.values + 1, right.values + right.count, right.values);
+                right.count--;
+                parent.keys[slot] = right.keys[0];
+                return;
+            }
+        }
+
+        // Both siblings are at the minimum: merge the right one of the pair
+        // into the left one and drop it from the parent
+        int leftSlot = slot > 0 ? slot - 1 : slot;
+        LeafNode& left = leaves[parent.children[leftSlot]];
+        uint32_t rightIndex = parent.children[leftSlot + 1];
+        LeafNode& right = leaves[rightIndex];
+        copy(right.keys, right.keys + right.count, left.keys + left.count);
+        copy(right.values, right.values + right.count, left.values + left.count);
+        left.count += right.count;
+        left.next = right.next;
+        freeLeaves.push_back(rightIndex);
+        removeFromInner(parent, leftSlot);
+        path.pop_back();
+        fixInnerUnderflow();
+    }
+
+    // The node that just lost a child (the former path.back()) may be too small
+    void fixInnerUnderflow() {
+        uint32_t index = path.empty() ? root : inners[path.back().first].children[path.back().second];
+        InnerNode& node = inners[index];
+        if (path.empty()) {
+            // The root only needs one child; with none left above, drop a level
+            if (node.count == 0) {
+                root = node.children[0];
+                freeInners.push_back(index);
+                height--;
+            }
+            return;
+        }
+        if (node.count >= innerCapacity / 2) {
+            return;
+        }
+
+        InnerNode& parent = inners[path.back().first];
+        int slot = path.back().second;
+        if (slot > 0) {
+            InnerNode& left = inners[parent.children[slot - 1]];
+            if (left.count > innerCapacity / 2) {
+                // Rotate through the parent: its separator comes down in
+                // front, the left sibling's last key goes up
+                copy_backward(node.keys, node.keys + node.count, node.keys + node.count + 1);
+                copy_backward(node.children, node.children + node.count + 1, node.children + node.count + 2);
+                node.keys[0] = parent.keys[slot - 1];
+                node.children[0] = left.children[left.count];
+                node.count++;
+                parent.keys[slot - 1] = left.keys[left.count - 1];
+                left.count--;
+                return;
+            }
+        }
+        if (slot < parent.count) {
+            InnerNode& right = inners[parent.children[slot + 1]];
+            if (right.count > innerCapacity / 2) {
+                node.keys[node.count] = parent.keys[slot];
+                node.children[node.count + 1] = right.children[0];
+                node.count++;
+                parent.keys[slot] = right.keys[0];
+                copy(right.keys + 1, right.keys + right.count, right.keys);
+                copy(right.children + 1, right.children + right.count + 1, right.children);
+                right.count--;
+                return;
+            }
+        }
+
+        // Merge the pair around separator leftSlot: left keys, separator, right keys
+        int leftSlot = slot > 0 ? slot - 1 : slot;
+        InnerNode& left = inners[parent.children[leftSlot]];
+        uint32_t rightIndex = parent.children[leftSlot + 1];
+        InnerNode& right = inners[rightIndex];
+        left.keys[left.count] = parent.keys[leftSlot];
+        copy(right.keys, right.keys + right.count, left.keys + left.count + 1);
+        copy(right.children, right.children + right.count + 1, left.children + left.count + 1);
+        left.count += right.count + 1;
+        freeInners.push_back(rightIndex);
+        removeFromInner(parent, leftSlot);
+        path.pop_back();
+        fixInnerUnderflow();
+    }
+};
+
+/**
+ * Compares the B+ tree with std::set, a red-black tree with one heap node
+ * (and so about one cache miss) per level, on n random keys:
+ * build, random lookups, a full ordered scan, then erasing half the keys
+ *
+ * Usage: ./bplus_tree bench [n]
+ */
+void runBenchmark(int n) {
+    mt19937 rng(42);
+    vector<int> keys(n);
+    for (int& key : keys) {
+        key = (int)(rng() & 0x7fffffff);
+    }
+    vector<int> probes(keys);
+    shuffle(probes.begin(), probes.end(), rng);
+
+    auto seconds = [](chrono::steady_clock::time_point start) {
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    };
+
+    auto t0 = chrono::steady_clock::now();
+    BPlusTree tree;
+    for (int key : keys) {
+        tree.insert(key, key ^ 0x5555);
+    }
+    double treeBuild = seconds(t0);
+    t0 = chrono::steady_clock::now();
+    set<int> reference(keys.begin(), keys.end());
+    double setBuild = seconds(t0);
+
+    t0 = chrono::steady_clock::now();
+    long long treeFound = 0;
+    for (int key : probes) {
+        const int* value = tree.find(key);
+        treeFound += value != nullptr && *value == (key ^ 0x5555);
+    }
+    double treeFind = seconds(t0);
+    t0 = chrono::steady_clock::now();
+    long long setFound = 0;
+    for (int key : probes) {
+        setFound += reference.count(key);
+    }
+    double setFind = seconds(t0);
+
+    t0 = chrono::steady_clock::now();
+    long long treeSum = 0, scanned = 0;
+    tree.scan(INT_MIN, INT_MAX, [&](int key, int) {
+        treeSum += key;
+        scanned++;
+    });
+    double treeScan = seconds(t0);
+    t0 = chrono::steady_clock::now();
+    long long setSum = 0;
+    for (int key : reference) {
+        setSum += key;
+    }
+    double setScan = seconds(t0);
+
+    // Sequential sum over a plain array of the same bytes, for the bandwidth
+    t0 = chrono::steady_clock::now();
+    long long arraySum = 0;
+    for (int key : keys) {
+        arraySum += key;
+    }
+    double arrayScan = seconds(t0);
+
+    bool same = treeFound == (long long)probes.size() && setFound == (long long)probes.size()
+                && treeSum == setSum && scanned == (long long)reference.size() && tree.size() == reference.size();
+    size_t distinct = tree.size();
+
+    // Erase every other probe (duplicates may repeat a key), then compare the contents
+    vector<int> victims;
+    for (size_t i = 1; i < probes.size(); i += 2) {
+        victims.push_back(probes[i]);
+    }
+    t0 = chrono::steady_clock::now();
+    size_t treeErased = 0;
+    for (int key : victims) {
+        treeErased += tree.erase(key);
+    }
+    double treeErase = seconds(t0);
+    t0 = chrono::steady_clock::now();
+    size_t setErased = 0;
+    for (int key : victims) {
+        setErased += reference.erase(key);
+    }
+    double setErase = seconds(t0);
+    BPlusTree::Cursor cursor = tree.begin();
+    for (int key : reference) {
+        same = same && cursor.valid() && cursor.key() == key;
+        cursor.next();
+    }
+    same = same && !cursor.valid() && treeErased == setErased && tree.size() == reference.size();
+
+    double lookups = (double)probes.size();
+    double scanBytes = 2.0 * sizeof(int) * distinct;
+    cout << n << " random keys, " << distinct << " distinct" << (same ? "" : " (MISMATCH)") << endl;
+    cout << "  B+ tree:  " << tree.levels() << " levels, " << tree.memoryBytes() / 1e6 << " MB, build "
+         << treeBuild * 1000 << " ms, find " << treeFind / lookups * 1e9 << " ns, scan "
+         << treeScan * 1000 << " ms (" << scanBytes / treeScan / 1e9 << " GB/s of keys and values), erase half "
+         << treeErase * 1000 << " ms" << endl;
+    cout << "  std::set: build " << setBuild * 1000 << " ms, find " << setFind / lookups * 1e9 << " ns, scan "
+         << setScan * 1000 << " ms (" << scanBytes / setScan / 1e9 << " GB/s), erase half "
+         << setErase * 1000 << " ms" << endl;
+    cout << "  array sum: " << arrayScan * 1000 << " ms (" << sizeof(int) * keys.size() / arrayScan / 1e9
+         << " GB/s, " << arraySum % 2 << ")" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "bench") {
+        runBenchmark(argc > 2 ? stoi(argv[2]) : 10000000);
+        return 0;
+    }
+
+    // Ordered index over sorted inserts, the worst case for a plain BST
+    BPlusTree tree;
+    for (int key = 1; key <= 1000; key++) {
+        tree.insert(key, key * key);
+    }
+    cout << "1000 keys in " << tree.levels() << " levels" << endl;
+
+    const int* value = tree.find(30);
+    cout << "find(30) = " << (value != nullptr ? to_string(*value) : "not found") << endl;
+
+    for (int key = 1; key <= 1000; key += 2) {
+        tree.erase(key);
+    }
+    cout << "Keys in [40, 60] after erasing the odd ones:";
+    tree.scan(40, 60, [](int key, int) {
+        cout << " " << key;
+    });
+    cout << endl;
+    return 0;
+}
@@ -7,11 +7,17 @@
  * @param data - Integer value stored in the node
  * @param left - Pointer to the left child node (contains smaller values)
  * @param right - Pointer to the right child node (contains larger values)
+ * @param height - Height of the subtree rooted at this node (leaf = 1)
+ *
+ * The tree is kept AVL-balanced: after every insert and erase the heights of
+ * the two subtrees of any node differ by at most one, so the height stays
+ * O(log n) even when the values arrive in sorted order.
  */
 struct Node {
     int data;
     struct Node* left;
     struct Node* right;
+    int height;
 };
 
 /**
@@ -33,10 +39,90 @@ struct Node* createNode(int data) {
     newNode->data = data;
     newNode->left = NULL;
     newNode->right = NULL;
+    newNode->height = 1;
     
     return newNode;
 }
 
+/**
+ * Returns the height of a subtree (0 for an empty one)
+ */
+int height(struct Node* node) {
+    return node == NULL ? 0 : node->height;
+}
+
+/**
+ * Recomputes a node's height from the heights of its children
+ */
+void updateHeight(struct Node* node) {
+    int left = height(node->left);
+    int right = height(node->right);
+    node->height = (left > right ? left : right) + 1;
+}
+
+/**
+ * Rotates a subtree to the right: the left child becomes the subtree root
+ * and the old root becomes its right child
+ *
+ * @param root - Root of the subtree; must have a left child
+ * @return struct Node* - The new root of the subtree
+ */
+struct Node* rotateRight(struct Node* root) {
+    struct Node* pivot = root->left;
+    root->left = pivot->right;
+    pivot->right = root;
+    updateHeight(root);
+    updateHeight(pivot);
+    return pivot;
+}
+
+/**
+ * Rotates a subtree to the left (mirror image of rotateRight)
+ *
+ * @param root - Root of the subtree; must have a right child
+ * @return struct Node* - The new root of the subtree
+ */
+struct Node* rotateLeft(struct Node* root) {
+    struct Node* pivot = root->right;
+    root->right = pivot->left;
+    pivot->left = root;
+    updateHeight(root);
+    updateHeight(pivot);
+    return pivot;
+}
+
+/**
+ * Restores the AVL property at a node whose subtrees are balanced but may
+ * differ in height by two
+ *
+ * If the taller child leans towards the inside (left-right or right-left
+ * case), that child is rotated first; one rotation at the root then
+ * balances the subtree.
+ *
+ * @param root - Root of the subtree
+ * @return struct Node* - The new root of the subtree
+ */
+struct Node* rebalance(struct Node* root) {
+    updateHeight(root);
+    int balance = height(root->left) - height(root->right);
+    
+    // Left subtree too tall
+    if (balance > 1) {
+        if (height(root->left->left) < height(root->left->right)) {
+            root->left = rotateLeft(root->left);
+        }
+        return rotateRight(root);
+    }
+    // Right subtree too tall
+    if (balance < -1) {
+        if (height(root->right->right) < height(root->right->left)) {
+            root->right = rotateRight(root->right);
+        }
+        return rotateLeft(root);
+    }
+    return root;
+}
+
 /**
  * Inserts a new element into the Binary Search Tree
  * 
@@ -49,10 +135,11 @@ struct Node* createNode(int data) {
  * @param data - The integer value to insert into the BST
  * @return struct Node* - Pointer to the root of the modified BST
  * 
- * Time Complexity: O(h) where h is the height of the tree
- *                  Best case: O(log n) for balanced tree
- *                  Worst case: O(n) for skewed tree
- * Space Complexity: O(h) due to recursive call stack
+ * Every node on the path back from the insertion point is rebalanced, so
+ * the returned root may be a different node than the one passed in.
+ *
+ * Time Complexity: O(log n) - the balancing keeps the height logarithmic
+ * Space Complexity: O(log n) due to recursive call stack
  * 
  * Example:
  *     struct Node* root = NULL;
@@ -77,6 +164,130 @@ struct Node* insert(struct Node* root, int data) {
         root->right = insert(root->right, data);
     }
     // If data is equal to current node's data, don't insert (no duplicates allowed)
-    // Simply return the unchanged root
+    // The subtree is unchanged, so the rebalance below leaves it as it is
     
-    // Return the (potentially modified) root pointer
\ No newline at end of file
+    // Return the (potentially modified) root pointer, rebalanced since the
+    // insertion may have made one side too tall
+    return rebalance(root);
+}
+
+/**
+ * Searches the Binary Search Tree for a value
+ *
+ * @param root - Pointer to the root node of the BST
+ * @param data - The integer value to look for
+ * @return struct Node* - The node holding data, or NULL if it is not present
+ *
+ * Time Complexity: O(log n)
+ */
+struct Node* search(struct Node* root, int data) {
+    // Base case: empty subtree (not found) or match
+    if (root == NULL || root->data == data) {
+        return root;
+    }
+    
+    // Continue in the subtree that can contain data
+    if (data < root->data) {
+        return search(root->left, data);
+    }
+    return search(root->right, data);
+}
+
+/**
+ * Removes a value from the Binary Search Tree
+ *
+ * - A node with no children is simply freed
+ * - A node with one child is replaced by that child
+ * - A node with two children copies the value of its inorder successor
+ *   (the smallest value in its right subtree), and the successor is then
+ *   erased from the right subtree
+ *
+ * @param root - Pointer to the root node of the BST
+ * @param data - The integer value to remove (absent values are ignored)
+ * @return struct Node* - Pointer to the root of the modified BST
+ *
+ * Time Complexity: O(log n)
+ * Space Complexity: O(log n) due to recursive call stack
+ */
+struct Node* erase(struct Node* root, int data) {
+    if (root == NULL) {
+        return NULL;
+    }
+    
+    if (data < root->data) {
+        root->left = erase(root->left, data);
+    }
+    else if (data > root->data) {
+        root->right = erase(root->right, data);
+    }
+    // Found the node: at most one child, replace it by that child
+    else if (root->left == NULL || root->right == NULL) {
+        struct Node* child = root->left != NULL ? root->left : root->right;
+        free(root);
+        return child;
+    }
+    // Two children: take over the inorder successor's value
+    else {
+        struct Node* successor = root->right;
+        while (successor->left != NULL) {
+            successor = successor->left;
+        }
+        root->data = successor->data;
+        root->right = erase(root->right, successor->data);
+    }
+    
+    return rebalance(root);
+}
+
+/**
+ * Prints the tree in sorted order (Left -> Root -> Right)
+ */
+void inorder(struct Node* root) {
+    if (root == NULL) {
+        return;
+    }
+    inorder(root->left);
+    printf("%d ", root->data);
+    inorder(root->right);
+}
+
+/**
+ * Frees every node of the tree (children before their parent)
+ */
+void freeTree(struct Node* root) {
+    if (root == NULL) {
+        return;
+    }
+    freeTree(root->left);
+    freeTree(root->right);
+    free(root);
+}
+
+/**
+ * Builds a tree from sorted values, the input that degrades an unbalanced
+ * BST into a linked list, then searches and erases a few values
+ */
+int main(void) {
+    struct Node* root = NULL;
+    
+    // Insert 1..1000 in ascending order
+    for (int value = 1; value <= 1000; value++) {
+        root = insert(root, value);
+    }
+    printf("Height after 1000 sorted inserts: %d (an unbalanced BST would have 1000)\n", height(root));
+    
+    // Search for a present and an absent value
+    printf("search(500): %s\n", search(root, 500) != NULL ? "found" : "not found");
+    printf("search(1001): %s\n", search(root, 1001) != NULL ? "found" : "not found");
+    
+    // Erase everything above 10 and print what is left
+    for (int value = 11; value <= 1000; value++) {
+        root = erase(root, value);
+    }
+    printf("After erasing 11..1000 (height %d): ", height(root));
+    inorder(root);
+    printf("\n");
+    
+    freeTree(root);
+    return 0;
+}